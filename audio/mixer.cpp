@@ -22,6 +22,8 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -44,7 +46,7 @@ namespace Audio {
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality);
 	~Channel();
 
 	/**
@@ -58,10 +60,16 @@ public:
 	 */
 	int mix(int16 *data, uint len);
 
+	/**
+	 * Queries whether the last call to mix() ran out of data although the
+	 * channel had been producing samples before and is not finished yet.
+	 */
+	bool hasUnderrun() const { return _underrun; }
+
 	/**
 	 * Queries whether the channel is still playing or not.
 	 */
-	bool isFinished() const { return _stream->endOfStream(); }
+	bool isFinished() const { return _stream->endOfStream() && _drained; }
 
 	/**
 	 * Queries whether the channel is a permanent channel.
@@ -150,6 +158,9 @@ private:
 	bool _permanent;
 	int _pauseLevel;
 	int _id;
+	bool _underrun;
+	bool _producing;
+	bool _drained;
 
 	byte _volume;
 	int8 _balance;
@@ -175,17 +186,35 @@ private:
 
 // TODO: parameter "system" is unused
 MixerImpl::MixerImpl(OSystem *system, uint sampleRate)
-	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _resamplerQuality(kRateConverterLinear), _commandMutex(), _commandHead(0), _commandTail(0), _stats() {
 
 	assert(sampleRate > 0);
 
+	// There is no GUI option for this; advanced users who prefer quality
+	// over speed can select the resampler in their config file directly
+	const char *const appDomain = Common::ConfigManager::kApplicationDomain;
+	if (ConfMan.hasKey("resampler_quality", appDomain)) {
+		const Common::String quality = ConfMan.get("resampler_quality", appDomain);
+		if (quality == "sinc")
+			_resamplerQuality = kRateConverterSinc;
+		else if (quality != "linear")
+			warning("Unknown resampler_quality '%s', using linear", quality.c_str());
+	}
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = 0;
 }
 
 MixerImpl::~MixerImpl() {
+	debug(1, "MixerImpl: %u blocks mixed, %u underruns, %u commands applied (%u overflowed), max command latency %u ms, max mix time %u ms",
+		_stats.mixBlocks, _stats.underruns, _stats.commandsApplied, _stats.commandsOverflowed,
+		_stats.maxCommandLatency, _stats.maxMixTime);
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	freeRateConverterCaches();
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -196,6 +225,93 @@ uint MixerImpl::getOutputRate() const {
 	return _sampleRate;
 }
 
+void MixerImpl::postCommand(Command::Type type, SoundHandle handle, int value) {
+	Command cmd;
+	cmd.type = type;
+	cmd.handle = handle;
+	cmd.value = value;
+	cmd.time = g_system->getMillis(true);
+
+	{
+		Common::StackLock lock(_commandMutex);
+		if (_commandTail - _commandHead < COMMAND_QUEUE_SIZE) {
+			_commands[_commandTail % COMMAND_QUEUE_SIZE] = cmd;
+			_commandTail++;
+			return;
+		}
+
+		_stats.commandsOverflowed++;
+	}
+
+	// The queue is full, which means the audio thread is not running (or
+	// not keeping up). Apply the command synchronously instead.
+	Common::StackLock lock(_mutex);
+	flushCommands();
+	applyCommand(cmd);
+}
+
+bool MixerImpl::findPendingCommand(Command::Type type, SoundHandle handle, int &value) {
+	Common::StackLock lock(_commandMutex);
+
+	for (uint i = _commandTail; i != _commandHead; i--) {
+		const Command &cmd = _commands[(i - 1) % COMMAND_QUEUE_SIZE];
+		if (cmd.type == type && cmd.handle._val == handle._val) {
+			value = cmd.value;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void MixerImpl::flushCommands() {
+	const uint32 now = g_system->getMillis(true);
+
+	while (true) {
+		Command cmd;
+		{
+			Common::StackLock lock(_commandMutex);
+			if (_commandHead == _commandTail)
+				break;
+
+			cmd = _commands[_commandHead % COMMAND_QUEUE_SIZE];
+			_commandHead++;
+
+			_stats.commandsApplied++;
+			if (now > cmd.time && now - cmd.time > _stats.maxCommandLatency)
+				_stats.maxCommandLatency = now - cmd.time;
+		}
+
+		applyCommand(cmd);
+	}
+}
+
+void MixerImpl::applyCommand(const Command &cmd) {
+	const int index = cmd.handle._val % NUM_CHANNELS;
+
+	switch (cmd.type) {
+	case Command::kSetVolume:
+		if (_channels[index] && _channels[index]->getHandle()._val == cmd.handle._val)
+			_channels[index]->setVolume(cmd.value);
+		break;
+
+	case Command::kSetBalance:
+		if (_channels[index] && _channels[index]->getHandle()._val == cmd.handle._val)
+			_channels[index]->setBalance(cmd.value);
+		break;
+
+	case Command::kNotifyTypeVolume:
+		for (int i = 0; i != NUM_CHANNELS; ++i) {
+			if (_channels[i] && _channels[i]->getType() == (SoundType)cmd.value)
+				_channels[i]->notifyGlobalVolChange();
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
 void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -230,6 +346,7 @@ void MixerImpl::playStream(
 			bool permanent,
 			bool reverseStereo) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 
 	if (stream == 0) {
 		warning("stream is 0");
@@ -260,7 +377,7 @@ void MixerImpl::playStream(
 #endif
 
 	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent, _resamplerQuality);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
 	insertChannel(handle, chan);
@@ -271,6 +388,11 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 
 	Common::StackLock lock(_mutex);
 
+	const uint32 startTime = g_system->getMillis(true);
+
+	// Apply the channel operations posted since the last block
+	flushCommands();
+
 	int16 *buf = (int16 *)samples;
 	// we store stereo, 16-bit samples
 	assert(len % 4 == 0);
@@ -284,6 +406,7 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 
 	// mix all channels
 	int res = 0, tmp;
+	uint32 underruns = 0;
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
@@ -294,14 +417,25 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 
 				if (tmp > res)
 					res = tmp;
+				if (_channels[i]->hasUnderrun())
+					underruns++;
 			}
 		}
 
+	const uint32 mixTime = g_system->getMillis(true) - startTime;
+
+	Common::StackLock statsLock(_commandMutex);
+	_stats.mixBlocks++;
+	_stats.underruns += underruns;
+	if (mixTime > _stats.maxMixTime)
+		_stats.maxMixTime = mixTime;
+
 	return res;
 }
 
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != 0 && !_channels[i]->isPermanent()) {
 			delete _channels[i];
@@ -312,6 +446,7 @@ void MixerImpl::stopAll() {
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != 0 && _channels[i]->getId() == id) {
 			delete _channels[i];
@@ -322,6 +457,7 @@ void MixerImpl::stopID(int id) {
 
 void MixerImpl::stopHandle(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 
 	// Simply ignore stop requests for handles of sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
@@ -336,10 +472,7 @@ void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 	_soundTypeSettings[type].mute = mute;
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	postCommand(Command::kNotifyTypeVolume, SoundHandle(), type);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
@@ -348,16 +481,14 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setVolume(volume);
+	postCommand(Command::kSetVolume, handle, volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
+	int pending;
+	if (findPendingCommand(Command::kSetVolume, handle, pending))
+		return pending;
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -366,16 +497,14 @@ byte MixerImpl::getChannelVolume(SoundHandle handle) {
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
-
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setBalance(balance);
+	postCommand(Command::kSetBalance, handle, balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
+	int pending;
+	if (findPendingCommand(Command::kSetBalance, handle, pending))
+		return pending;
+
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return 0;
@@ -389,6 +518,7 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
@@ -398,7 +528,10 @@ Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 }
 
 void MixerImpl::pauseAll(bool paused) {
+	// Pausing is applied immediately, as callers rely on paused streams not
+	// being read anymore once this returns
 	Common::StackLock lock(_mutex);
+	flushCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != 0) {
 			_channels[i]->pause(paused);
@@ -408,6 +541,7 @@ void MixerImpl::pauseAll(bool paused) {
 
 void MixerImpl::pauseID(int id, bool paused) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != 0 && _channels[i]->getId() == id) {
 			_channels[i]->pause(paused);
@@ -418,6 +552,7 @@ void MixerImpl::pauseID(int id, bool paused) {
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 
 	// Simply ignore (un)pause requests for sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
@@ -429,6 +564,7 @@ void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
 
 bool MixerImpl::isSoundIDActive(int id) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
@@ -450,6 +586,7 @@ int MixerImpl::getSoundID(SoundHandle handle) {
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
@@ -461,6 +598,7 @@ bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
 	Common::StackLock lock(_mutex);
+	flushCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i] && _channels[i]->getType() == type)
 			return true;
@@ -480,6 +618,7 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// scaling? See also Player_V2::setMasterVolume
 
 	Common::StackLock lock(_mutex);
+	flushCommands();
 	_soundTypeSettings[type].volume = volume;
 
 	for (int i = 0; i != NUM_CHANNELS; ++i) {
@@ -500,16 +639,17 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 #pragma mark -
 
 Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-                 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
+                 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent,
+                 RateConverterQuality quality)
     : _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
-      _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
+      _balance(0), _pauseLevel(0), _underrun(false), _producing(false), _drained(false), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
       _pauseStartTime(0), _pauseTime(0), _converter(0), _volL(0), _volR(0),
       _stream(stream, autofreeStream) {
 	assert(mixer);
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -610,11 +750,10 @@ Timestamp Channel::getElapsedTime() {
 int Channel::mix(int16 *data, uint len) {
 	assert(_stream);
 
+	assert(_converter);
+
 	int res = 0;
-	if (_stream->endOfData()) {
-		// TODO: call drain method
-	} else {
-		assert(_converter);
+	if (!_stream->endOfData()) {
 		_samplesConsumed = _samplesDecoded;
 		_mixerTimeStamp = g_system->getMillis(true);
 		_pauseTime = 0;
@@ -622,6 +761,20 @@ int Channel::mix(int16 *data, uint len) {
 		_samplesDecoded += res;
 	}
 
+	// Flush what is left in the converter once the stream has ended
+	if (_stream->endOfStream() && !_drained && (uint)res < len) {
+		const int drained = _converter->drain(data + res * 2, len - res, _volL, _volR);
+		_drained = (uint)drained < len - res;
+		res += drained;
+	}
+
+	// Only count the transition from producing samples to running dry, so
+	// that idle streams (e.g. an empty QueuingAudioStream) do not show up
+	// as an underrun in every single block.
+	const bool starved = (uint)res < len && !_stream->endOfStream();
+	_underrun = starved && _producing;
+	_producing = !starved;
+
 	return res;
 }
 
@@ -26,6 +26,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -51,7 +52,8 @@ namespace Audio {
 class MixerImpl : public Mixer {
 private:
 	enum {
-		NUM_CHANNELS = 16
+		NUM_CHANNELS = 16,
+		COMMAND_QUEUE_SIZE = 64
 	};
 
 	Common::Mutex _mutex;
@@ -70,6 +72,72 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	RateConverterQuality _resamplerQuality;
+
+	/**
+	 * A deferred channel operation. Volume and balance changes do not
+	 * need to be visible to the audio thread immediately, so instead of
+	 * waiting for the mixer lock (which is held for a whole mix pass) they
+	 * are queued here and applied at the start of the next mix block.
+	 */
+	struct Command {
+		enum Type {
+			kSetVolume,
+			kSetBalance,
+			kNotifyTypeVolume
+		};
+
+		Type type;
+		SoundHandle handle;
+		int value;
+		uint32 time;
+	};
+
+	/**
+	 * Guards the command queue only. It is never held for longer than it
+	 * takes to copy a command, so posting a command does not stall on the
+	 * audio thread. Lock order is always _mutex before _commandMutex.
+	 */
+	Common::Mutex _commandMutex;
+	Command _commands[COMMAND_QUEUE_SIZE];
+	uint _commandHead;
+	uint _commandTail;
+
+	/**
+	 * Counters describing how well the mixer keeps up with the backend.
+	 * Printed at debug level 1 when the mixer is destroyed.
+	 */
+	struct MixerStats {
+		MixerStats() : mixBlocks(0), underruns(0), commandsApplied(0), commandsOverflowed(0),
+			maxCommandLatency(0), maxMixTime(0) {}
+
+		/** Number of blocks mixed (i.e. calls to MixerImpl::mixCallback). */
+		uint32 mixBlocks;
+		/** Number of blocks in which an unfinished channel ran out of data. */
+		uint32 underruns;
+		/** Number of queued channel operations applied by the mixer. */
+		uint32 commandsApplied;
+		/** Number of channel operations which had to be applied synchronously because the queue was full. */
+		uint32 commandsOverflowed;
+		/** Longest time (in ms) between posting a channel operation and the mixer applying it. */
+		uint32 maxCommandLatency;
+		/** Longest time (in ms) spent in a single call to MixerImpl::mixCallback. */
+		uint32 maxMixTime;
+	};
+
+	MixerStats _stats;
+
+	void postCommand(Command::Type type, SoundHandle handle, int value);
+	bool findPendingCommand(Command::Type type, SoundHandle handle, int &value);
+	void applyCommand(const Command &cmd);
+
+	/**
+	 * Applies all queued commands. Must be called with _mutex held. Every
+	 * operation which takes _mutex calls this first, so that queued commands
+	 * are always applied in order with respect to starting and stopping
+	 * channels.
+	 */
+	void flushCommands();
 
 public:
 
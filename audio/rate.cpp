@@ -31,10 +31,26 @@
 #include "audio/audiostream.h"
 #include "audio/rate.h"
 #include "audio/mixer.h"
+#include "common/algorithm.h"
 #include "common/frac.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
+#include <math.h>
+
+// Use the vector unit for scaling and summing samples where the compiler
+// guarantees it is present (SSE2 is part of the x86-64 baseline, NEON of
+// AArch64 and of ARM builds using -mfpu=neon).
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#if defined(__SSE2__)
+#define RATE_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define RATE_USE_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 namespace Audio {
 
 
@@ -57,6 +73,148 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+#pragma mark -
+
+#ifdef RATE_USE_SSE2
+/**
+ * Computes (x * vol) / Mixer::kMaxMixerVolume for eight samples, rounding
+ * towards zero exactly like the scalar C division does.
+ */
+static inline __m128i scaleSamplesSSE2(__m128i x, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(x, vol);
+	const __m128i hi = _mm_mulhi_epi16(x, vol);
+	const __m128i bias = _mm_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+	p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), bias)), 8);
+	p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), bias)), 8);
+
+	return _mm_packs_epi32(p0, p1);
+}
+#endif
+
+#ifdef RATE_USE_NEON
+/**
+ * Computes (x * vol) / Mixer::kMaxMixerVolume for eight samples, rounding
+ * towards zero exactly like the scalar C division does.
+ */
+static inline int16x8_t scaleSamplesNEON(int16x8_t x, int16x8_t vol) {
+	const int32x4_t bias = vdupq_n_s32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	int32x4_t p0 = vmull_s16(vget_low_s16(x), vget_low_s16(vol));
+	int32x4_t p1 = vmull_s16(vget_high_s16(x), vget_high_s16(vol));
+	p0 = vshrq_n_s32(vaddq_s32(p0, vandq_s32(vshrq_n_s32(p0, 31), bias)), 8);
+	p1 = vshrq_n_s32(vaddq_s32(p1, vandq_s32(vshrq_n_s32(p1, 31), bias)), 8);
+
+	return vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1));
+}
+#endif
+
+/**
+ * Scales interleaved stereo sample pairs by the channel volumes and adds
+ * them (clamped) to the output buffer.
+ *
+ * The vector paths produce exactly the same output as the scalar loop.
+ */
+template<bool reverseStereo>
+static void mixStereoSamples(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t pairs, st_volume_t vol_l, st_volume_t vol_r) {
+#if defined(RATE_USE_SSE2)
+	// For reversed stereo the input pairs are swapped, so the volume for the
+	// right output channel is applied to the left input sample.
+	const int16 v0 = reverseStereo ? vol_r : vol_l;
+	const int16 v1 = reverseStereo ? vol_l : vol_r;
+	const __m128i vol = _mm_set_epi16(v1, v0, v1, v0, v1, v0, v1, v0);
+
+	for (; pairs >= 4; pairs -= 4) {
+		__m128i x = _mm_loadu_si128((const __m128i *)ibuf);
+		if (reverseStereo)
+			x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xB1), 0xB1);
+
+		const __m128i out = _mm_adds_epi16(_mm_loadu_si128((const __m128i *)obuf), scaleSamplesSSE2(x, vol));
+		_mm_storeu_si128((__m128i *)obuf, out);
+
+		ibuf += 8;
+		obuf += 8;
+	}
+#elif defined(RATE_USE_NEON)
+	const int16 v0 = reverseStereo ? vol_r : vol_l;
+	const int16 v1 = reverseStereo ? vol_l : vol_r;
+	const int16 volTable[8] = { v0, v1, v0, v1, v0, v1, v0, v1 };
+	const int16x8_t vol = vld1q_s16(volTable);
+
+	for (; pairs >= 4; pairs -= 4) {
+		int16x8_t x = vld1q_s16(ibuf);
+		if (reverseStereo)
+			x = vrev32q_s16(x);
+
+		vst1q_s16(obuf, vqaddq_s16(vld1q_s16(obuf), scaleSamplesNEON(x, vol)));
+
+		ibuf += 8;
+		obuf += 8;
+	}
+#endif
+
+	for (; pairs > 0; pairs--) {
+		// output left channel
+		clampedAdd(obuf[reverseStereo    ], (ibuf[0] * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		clampedAdd(obuf[reverseStereo ^ 1], (ibuf[1] * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		ibuf += 2;
+		obuf += 2;
+	}
+}
+
+/**
+ * Scales mono samples by the channel volumes and adds them (clamped) to
+ * both channels of the output buffer.
+ *
+ * The vector paths produce exactly the same output as the scalar loop.
+ */
+static void mixMonoSamples(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t samples, st_volume_t vol_l, st_volume_t vol_r) {
+#if defined(RATE_USE_SSE2)
+	const __m128i vol = _mm_set_epi16(vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l);
+
+	for (; samples >= 8; samples -= 8) {
+		const __m128i x = _mm_loadu_si128((const __m128i *)ibuf);
+		const __m128i out0 = _mm_adds_epi16(_mm_loadu_si128((const __m128i *)obuf), scaleSamplesSSE2(_mm_unpacklo_epi16(x, x), vol));
+		const __m128i out1 = _mm_adds_epi16(_mm_loadu_si128((const __m128i *)(obuf + 8)), scaleSamplesSSE2(_mm_unpackhi_epi16(x, x), vol));
+		_mm_storeu_si128((__m128i *)obuf, out0);
+		_mm_storeu_si128((__m128i *)(obuf + 8), out1);
+
+		ibuf += 8;
+		obuf += 16;
+	}
+#elif defined(RATE_USE_NEON)
+	const int16 volTable[8] = { (int16)vol_l, (int16)vol_r, (int16)vol_l, (int16)vol_r, (int16)vol_l, (int16)vol_r, (int16)vol_l, (int16)vol_r };
+	const int16x8_t vol = vld1q_s16(volTable);
+
+	for (; samples >= 8; samples -= 8) {
+		const int16x8x2_t x = vzipq_s16(vld1q_s16(ibuf), vld1q_s16(ibuf));
+		vst1q_s16(obuf, vqaddq_s16(vld1q_s16(obuf), scaleSamplesNEON(x.val[0], vol)));
+		vst1q_s16(obuf + 8, vqaddq_s16(vld1q_s16(obuf + 8), scaleSamplesNEON(x.val[1], vol)));
+
+		ibuf += 8;
+		obuf += 16;
+	}
+#endif
+
+	for (; samples > 0; samples--) {
+		// output left channel
+		clampedAdd(obuf[0], (*ibuf * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		clampedAdd(obuf[1], (*ibuf * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		ibuf++;
+		obuf += 2;
+	}
+}
+
+#pragma mark -
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -70,6 +228,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled sample pairs, before volume scaling */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** position of how far output is ahead of input */
 	/** Holds what would have been opos-ipos */
 	long opos;
@@ -80,7 +241,7 @@ protected:
 public:
 	SimpleRateConverter(st_rate_t inrate, st_rate_t outrate);
 	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
-	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		return ST_SUCCESS;
 	}
 };
@@ -118,38 +279,50 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
-
-		// read enough input samples so that opos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			opos--;
-			if (opos >= 0) {
-				inPtr += (stereo ? 2 : 1);
-			}
-		} while (opos >= 0);
-
-		st_sample_t out0, out1;
-		out0 = *inPtr++;
-		out1 = (stereo ? *inPtr++ : out0);
+	bool endOfInput = false;
+	while (obuf < oend && !endOfInput) {
+		// Resample a block into the intermediate output buffer, then scale
+		// and mix it in one go.
+		st_sample_t *tmp = outBuf;
+		st_sample_t *tmpEnd = outBuf + MIN<st_size_t>(oend - obuf, ARRAYSIZE(outBuf));
+
+		while (tmp < tmpEnd) {
+
+			// read enough input samples so that opos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				opos--;
+				if (opos >= 0) {
+					inPtr += (stereo ? 2 : 1);
+				}
+			} while (opos >= 0);
+
+			if (endOfInput)
+				break;
 
-		// Increment output position
-		opos += opos_inc;
+			st_sample_t out0, out1;
+			out0 = *inPtr++;
+			out1 = (stereo ? *inPtr++ : out0);
 
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			// Increment output position
+			opos += opos_inc;
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+			tmp[0] = out0;
+			tmp[1] = out1;
+			tmp += 2;
+		}
 
-		obuf += 2;
+		mixStereoSamples<reverseStereo>(obuf, outBuf, (tmp - outBuf) / 2, vol_l, vol_r);
+		obuf += tmp - outBuf;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -172,6 +345,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** interpolated sample pairs, before volume scaling */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** fractional position of the output stream in input stream unit */
 	frac_t opos;
 
@@ -186,7 +362,7 @@ protected:
 public:
 	LinearRateConverter(st_rate_t inrate, st_rate_t outrate);
 	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
-	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		return ST_SUCCESS;
 	}
 };
@@ -227,48 +403,433 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	ostart = obuf;
 	oend = obuf + osamp * 2;
 
-	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE_LOW <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+	bool endOfInput = false;
+	while (obuf < oend && !endOfInput) {
+		// Interpolate a block into the intermediate output buffer, then
+		// scale and mix it in one go.
+		st_sample_t *tmp = outBuf;
+		st_sample_t *tmpEnd = outBuf + MIN<st_size_t>(oend - obuf, ARRAYSIZE(outBuf));
+
+		while (tmp < tmpEnd) {
+
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE_LOW <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE_LOW;
 			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
+
+			if (endOfInput)
+				break;
+
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE_LOW && tmp < tmpEnd) {
+				// interpolate
+				st_sample_t out0, out1;
+				out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				out1 = (stereo ?
+							  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
+							  out0);
+
+				tmp[0] = out0;
+				tmp[1] = out1;
+				tmp += 2;
+
+				// Increment output position
+				opos += opos_inc;
 			}
-			opos -= FRAC_ONE_LOW;
 		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE_LOW && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						  out0);
+		mixStereoSamples<reverseStereo>(obuf, outBuf, (tmp - outBuf) / 2, vol_l, vol_r);
+		obuf += tmp - outBuf;
+	}
+	return (obuf - ostart) / 2;
+}
+
+#pragma mark -
+
+
+enum {
+	SINC_PHASE_BITS = 8,
+	SINC_PHASES = (1 << SINC_PHASE_BITS),
+	SINC_COEFF_BITS = 14,
+	SINC_MIN_TAPS = 16,
+	SINC_MAX_TAPS = 64,
+	SINC_CACHE_SIZE = 8
+};
+
+/**
+ * Coefficient table of a windowed-sinc low-pass filter, split into
+ * SINC_PHASES polyphase sub-filters of 'taps' coefficients each.
+ *
+ * The table only depends on the ratio of the input and output rates, so
+ * tables are cached and shared between all channels using the same ratio.
+ */
+struct SincFilter {
+	/** input/output rate ratio, reduced by the greatest common divisor */
+	st_rate_t inRatio, outRatio;
+	int taps;
+	int refCount;
+	bool cached;
+	int16 *coeffs;
+};
+
+/**
+ * Filter tables which are kept around for reuse. This cache is not locked:
+ * sinc converters must only be created and destroyed while holding the
+ * mixer lock (see makeRateConverter()).
+ */
+static SincFilter *s_sincFilters[SINC_CACHE_SIZE];
+
+static SincFilter *createSincFilter(st_rate_t inRatio, st_rate_t outRatio) {
+	SincFilter *filter = new SincFilter();
+	filter->inRatio = inRatio;
+	filter->outRatio = outRatio;
+	filter->refCount = 0;
+	filter->cached = false;
+
+	// When downsampling the filter has to cut off at the output Nyquist
+	// frequency, which needs proportionally more taps for the same quality.
+	// Cut off slightly early, so the transition band stays below Nyquist.
+	const double cutoff = 0.9 * MIN<double>(1.0, (double)outRatio / inRatio);
+	int taps = SINC_MIN_TAPS;
+	if (inRatio > outRatio)
+		taps = (int)ceil(SINC_MIN_TAPS * (double)inRatio / outRatio);
+	taps = CLIP<int>((taps + 7) & ~7, SINC_MIN_TAPS, SINC_MAX_TAPS);
+	filter->taps = taps;
+
+	filter->coeffs = new int16[SINC_PHASES * taps];
+
+	const double half = taps / 2;
+	double h[SINC_MAX_TAPS];
+	for (int phase = 0; phase < SINC_PHASES; ++phase) {
+		const double frac = (double)phase / SINC_PHASES;
+
+		// Tap k is applied to the input frame at distance d from the output
+		// position, which lies between taps half - 1 and half.
+		double sum = 0;
+		for (int k = 0; k < taps; ++k) {
+			const double d = k - (half - 1) - frac;
+			const double x = M_PI * cutoff * d;
+			const double sinc = (x == 0) ? 1.0 : sin(x) / x;
+			const double window = 0.42 + 0.5 * cos(M_PI * d / half) + 0.08 * cos(2 * M_PI * d / half);
+			h[k] = cutoff * sinc * window;
+			sum += h[k];
+		}
+
+		// Normalize every phase to unity gain, and put the rounding error
+		// into the center tap so DC passes through unchanged.
+		int16 *c = filter->coeffs + phase * taps;
+		int total = 0;
+		for (int k = 0; k < taps; ++k) {
+			c[k] = (int16)floor(h[k] / sum * (1 << SINC_COEFF_BITS) + 0.5);
+			total += c[k];
+		}
+		c[taps / 2 - 1] += (1 << SINC_COEFF_BITS) - total;
+	}
+
+	return filter;
+}
+
+static SincFilter *acquireSincFilter(st_rate_t inrate, st_rate_t outrate) {
+	const st_rate_t divisor = Common::gcd(inrate, outrate);
+	const st_rate_t inRatio = inrate / divisor;
+	const st_rate_t outRatio = outrate / divisor;
+
+	int freeSlot = -1;
+	for (int i = 0; i < SINC_CACHE_SIZE; ++i) {
+		SincFilter *filter = s_sincFilters[i];
+		if (!filter) {
+			if (freeSlot == -1)
+				freeSlot = i;
+		} else if (filter->inRatio == inRatio && filter->outRatio == outRatio) {
+			filter->refCount++;
+			return filter;
+		} else if (filter->refCount == 0 && (freeSlot == -1 || s_sincFilters[freeSlot])) {
+			freeSlot = i;
+		}
+	}
+
+	SincFilter *filter = createSincFilter(inRatio, outRatio);
+	filter->refCount = 1;
+
+	if (freeSlot != -1) {
+		if (s_sincFilters[freeSlot]) {
+			delete[] s_sincFilters[freeSlot]->coeffs;
+			delete s_sincFilters[freeSlot];
+		}
+		s_sincFilters[freeSlot] = filter;
+		filter->cached = true;
+	}
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+	return filter;
+}
+
+static void releaseSincFilter(SincFilter *filter) {
+	// Cached filters stay around for later channels using the same ratio
+	if (--filter->refCount == 0 && !filter->cached) {
+		delete[] filter->coeffs;
+		delete filter;
+	}
+}
+
+void freeRateConverterCaches() {
+	for (int i = 0; i < SINC_CACHE_SIZE; ++i) {
+		SincFilter *filter = s_sincFilters[i];
+		if (!filter)
+			continue;
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		// Filters still in use are freed by their last converter instead
+		if (filter->refCount == 0) {
+			delete[] filter->coeffs;
+			delete filter;
+		} else {
+			filter->cached = false;
+		}
+		s_sincFilters[i] = 0;
+	}
+}
 
-			obuf += 2;
+/**
+ * Applies one polyphase sub-filter to the given input samples and returns
+ * the clamped result.
+ */
+static inline st_sample_t applySincFilter(const int16 *coeffs, const st_sample_t *samples, int taps) {
+	int sum;
+
+#if defined(RATE_USE_SSE2)
+	__m128i acc = _mm_setzero_si128();
+	for (int k = 0; k < taps; k += 8) {
+		const __m128i c = _mm_loadu_si128((const __m128i *)(coeffs + k));
+		const __m128i x = _mm_loadu_si128((const __m128i *)(samples + k));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(c, x));
+	}
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4E));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xB1));
+	sum = _mm_cvtsi128_si32(acc);
+#elif defined(RATE_USE_NEON)
+	int32x4_t acc = vdupq_n_s32(0);
+	for (int k = 0; k < taps; k += 8) {
+		const int16x8_t c = vld1q_s16(coeffs + k);
+		const int16x8_t x = vld1q_s16(samples + k);
+		acc = vmlal_s16(acc, vget_low_s16(c), vget_low_s16(x));
+		acc = vmlal_s16(acc, vget_high_s16(c), vget_high_s16(x));
+	}
+	const int32x2_t acc2 = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+	sum = vget_lane_s32(vpadd_s32(acc2, acc2), 0);
+#else
+	sum = 0;
+	for (int k = 0; k < taps; ++k)
+		sum += coeffs[k] * samples[k];
+#endif
+
+	sum = (sum + (1 << (SINC_COEFF_BITS - 1))) >> SINC_COEFF_BITS;
+	return (st_sample_t)CLIP<int>(sum, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+}
+
+/**
+ * Audio rate converter based on a windowed-sinc polyphase filter.
+ *
+ * The fractional output position is quantized to SINC_PHASES steps, each
+ * of which has its own precomputed set of filter coefficients.
+ *
+ * Limited to sampling frequency <= 131071 Hz.
+ */
+template<bool stereo, bool reverseStereo>
+class SincRateConverter : public RateConverter {
+protected:
+	enum {
+		HISTORY_SIZE = INTERMEDIATE_BUFFER_SIZE + SINC_MAX_TAPS
+	};
+
+	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	/** filtered sample pairs, before volume scaling */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	/** input frames (one array per channel) the filter is applied to */
+	st_sample_t history[stereo ? 2 : 1][HISTORY_SIZE];
+	/** number of valid frames in history */
+	int historyLen;
+	/** first frame in history used for the next output sample */
+	int historyPos;
+
+	/** fractional position of the output stream in input stream unit */
+	frac_t opos;
+
+	/** fractional position increment in the output stream */
+	frac_t opos_inc;
+
+	/** frames of silence still to be appended once the input has ended */
+	int tailLen;
+
+	/**
+	 * input frames the output position has already stepped over, which
+	 * still have to be discarded. Only happens when downsampling by more
+	 * than the filter length.
+	 */
+	int skipLen;
+
+	SincFilter *_filter;
+
+	bool refill(AudioStream *input);
+	int filter(AudioStream *input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+
+public:
+	SincRateConverter(st_rate_t inrate, st_rate_t outrate);
+	~SincRateConverter();
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return filter(&input, obuf, osamp, vol_l, vol_r);
+	}
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		return filter(0, obuf, osamp, vol_l, vol_r);
+	}
+};
+
+template<bool stereo, bool reverseStereo>
+SincRateConverter<stereo, reverseStereo>::SincRateConverter(st_rate_t inrate, st_rate_t outrate) {
+	if (inrate >= 131072 || outrate >= 131072) {
+		error("rate effect can only handle rates < 131072");
+	}
+
+	_filter = acquireSincFilter(inrate, outrate);
+
+	opos = 0;
+	opos_inc = (inrate << FRAC_BITS_LOW) / outrate;
+
+	// Start with silence, so that the first output sample is centered on
+	// the first input frame.
+	historyPos = 0;
+	historyLen = _filter->taps / 2 - 1;
+	memset(history, 0, sizeof(history));
+
+	// The last input frames are still in the filter's delay line when the
+	// input ends; drain() pushes them out by appending silence.
+	tailLen = _filter->taps / 2;
+	skipLen = 0;
+}
+
+template<bool stereo, bool reverseStereo>
+SincRateConverter<stereo, reverseStereo>::~SincRateConverter() {
+	releaseSincFilter(_filter);
+}
+
+template<bool stereo, bool reverseStereo>
+bool SincRateConverter<stereo, reverseStereo>::refill(AudioStream *input) {
+	const int channels = stereo ? 2 : 1;
+
+	// The output may have stepped past the end of the history, in which
+	// case the frames in between never make it into the history at all
+	if (historyPos > historyLen) {
+		skipLen += historyPos - historyLen;
+		historyPos = historyLen;
+	}
+
+	// Drop the frames which are not needed anymore
+	if (historyPos > 0) {
+		for (int ch = 0; ch < channels; ++ch)
+			memmove(history[ch], history[ch] + historyPos, (historyLen - historyPos) * sizeof(st_sample_t));
+		historyLen -= historyPos;
+		historyPos = 0;
+	}
+
+	// Without an input stream, pad the history with silence instead
+	if (!input) {
+		const int skipped = MIN<int>(skipLen, tailLen);
+		skipLen -= skipped;
+		tailLen -= skipped;
+
+		const int frames = MIN<int>(HISTORY_SIZE - historyLen, tailLen);
+		if (frames <= 0)
+			return false;
+
+		for (int ch = 0; ch < channels; ++ch)
+			memset(history[ch] + historyLen, 0, frames * sizeof(st_sample_t));
+		historyLen += frames;
+		tailLen -= frames;
+		return true;
+	}
+
+	const int frames = MIN<int>(HISTORY_SIZE - historyLen, ARRAYSIZE(inBuf) / channels);
+	const int len = input->readBuffer(inBuf, frames * channels);
+	if (len <= 0)
+		return false;
+
+	const int skipped = MIN<int>(skipLen, len / channels);
+	skipLen -= skipped;
+
+	const st_sample_t *inPtr = inBuf + skipped * channels;
+	for (int i = skipped; i < len / channels; ++i) {
+		history[0][historyLen] = *inPtr++;
+		if (stereo)
+			history[stereo ? 1 : 0][historyLen] = *inPtr++;
+		historyLen++;
+	}
+
+	return true;
+}
+
+template<bool stereo, bool reverseStereo>
+int SincRateConverter<stereo, reverseStereo>::filter(AudioStream *input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t *ostart, *oend;
+
+	ostart = obuf;
+	oend = obuf + osamp * 2;
+
+	const int taps = _filter->taps;
+
+	bool endOfInput = false;
+	while (obuf < oend && !endOfInput) {
+		// Filter a block into the intermediate output buffer, then scale
+		// and mix it in one go.
+		st_sample_t *tmp = outBuf;
+		st_sample_t *tmpEnd = outBuf + MIN<st_size_t>(oend - obuf, ARRAYSIZE(outBuf));
+
+		while (tmp < tmpEnd) {
+			// Make sure all frames covered by the filter are available
+			while (historyPos + taps > historyLen) {
+				if (!refill(input)) {
+					endOfInput = true;
+					break;
+				}
+			}
+
+			if (endOfInput)
+				break;
+
+			const int16 *coeffs = _filter->coeffs + (opos >> (FRAC_BITS_LOW - SINC_PHASE_BITS)) * taps;
+
+			st_sample_t out0, out1;
+			out0 = applySincFilter(coeffs, history[0] + historyPos, taps);
+			out1 = (stereo ? applySincFilter(coeffs, history[stereo ? 1 : 0] + historyPos, taps) : out0);
+
+			tmp[0] = out0;
+			tmp[1] = out1;
+			tmp += 2;
 
 			// Increment output position
 			opos += opos_inc;
+			historyPos += opos >> FRAC_BITS_LOW;
+			opos &= FRAC_ONE_LOW - 1;
 		}
+
+		mixStereoSamples<reverseStereo>(obuf, outBuf, (tmp - outBuf) / 2, vol_l, vol_r);
+		obuf += tmp - outBuf;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -293,7 +854,6 @@ public:
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
 		st_size_t len;
 
 		st_sample_t *ostart = obuf;
@@ -315,24 +875,17 @@ public:
 		len = input.readBuffer(_buffer, osamp);
 
 		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
+		if (stereo) {
+			mixStereoSamples<reverseStereo>(obuf, _buffer, len / 2, vol_l, vol_r);
+			obuf += len;
+		} else {
+			mixMonoSamples(obuf, _buffer, len, vol_l, vol_r);
+			obuf += len * 2;
 		}
 		return (obuf - ostart) / 2;
 	}
 
-	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		return ST_SUCCESS;
 	}
 };
@@ -341,9 +894,11 @@ public:
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0 && (inrate < 65536)) {
+		if (quality == kRateConverterSinc) {
+			return new SincRateConverter<stereo, reverseStereo>(inrate, outrate);
+		} else if ((inrate % outrate) == 0 && (inrate < 65536)) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -356,14 +911,14 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, quality);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, quality);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, quality);
 }
 
 } // End of namespace Audio
@@ -65,6 +65,17 @@ static inline void clampedAdd(int16& a, int b) {
 #endif
 }
 
+/**
+ * The resampling algorithm used by rate converters which need to change
+ * the sample rate.
+ */
+enum RateConverterQuality {
+	/** Sample dropping for integral ratios, linear interpolation otherwise. */
+	kRateConverterLinear,
+	/** Windowed-sinc polyphase filter. Slower, but avoids most aliasing. */
+	kRateConverterSinc
+};
+
 class RateConverter {
 public:
 	RateConverter() {}
@@ -75,10 +86,30 @@ public:
 	 */
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
-	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
+	/**
+	 * Flushes the samples still buffered inside the converter, once the
+	 * input stream has ended.
+	 *
+	 * @return Number of sample pairs written into the buffer. Less than
+	 *         osamp once the converter is completely drained.
+	 */
+	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * Creates a rate converter.
+ *
+ * Converters using kRateConverterSinc share filter tables without any
+ * locking, so they must only be created and destroyed while holding the
+ * mixer lock.
+ */
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateConverterLinear);
+
+/**
+ * Frees the filter tables cached by sinc rate converters. Called by the
+ * mixer on destruction.
+ */
+void freeRateConverterCaches();
 
 } // End of namespace Audio
 
@@ -173,6 +173,19 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Retrieves the size and the time of the last modification of the file
+	 * referred by this node, without opening it.
+	 *
+	 * The default implementation does not know anything about the file.
+	 *
+	 * @param size the size of the file in bytes
+	 * @param modificationTime the time of the last modification, in seconds
+	 *                         since an unspecified, but fixed, epoch
+	 * @return bool true if the information is available, false otherwise.
+	 */
+	virtual bool getFileInfo(uint32 &size, uint32 &modificationTime) const { return false; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
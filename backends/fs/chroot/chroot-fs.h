@@ -42,6 +42,7 @@ public:
 	virtual bool isDirectory() const;
 	virtual bool isReadable() const;
 	virtual bool isWritable() const;
+	virtual bool getFileInfo(uint32 &size, uint32 &modificationTime) const;
 
 	virtual AbstractFSNode *getChild(const Common::String &n) const;
 	virtual bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const;
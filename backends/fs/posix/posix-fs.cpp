@@ -32,7 +32,11 @@
 
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/stdiostream.h"
+#ifdef POSIX
+#include "backends/fs/posix/posix-mmapstream.h"
+#endif
 #include "common/algorithm.h"
+#include "common/config-manager.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -59,6 +63,17 @@ void POSIXFilesystemNode::setFlags() {
 	_isDirectory = _isValid ? S_ISDIR(st.st_mode) : false;
 }
 
+bool POSIXFilesystemNode::getFileInfo(uint32 &size, uint32 &modificationTime) const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return false;
+
+	size = (uint32)st.st_size;
+	modificationTime = (uint32)st.st_mtime;
+	return true;
+}
+
 POSIXFilesystemNode::POSIXFilesystemNode(const Common::String &p) {
 	assert(p.size() > 0);
 
@@ -251,6 +266,19 @@ AbstractFSNode *POSIXFilesystemNode::getParent() const {
 }
 
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
+#ifdef POSIX
+	// Large game data files can be mapped into memory, which avoids the
+	// stdio buffering and per read seeks, and lets users of getDataPointer()
+	// access them in place. This is opt-in, since a mapped file which gets
+	// truncated by another process crashes ScummVM with SIGBUS on the next
+	// access. Fall back to stdio if mapping is not possible.
+	const char *const appDomain = Common::ConfigManager::kApplicationDomain;
+	if (ConfMan.hasKey("mmap_files", appDomain) && ConfMan.getBool("mmap_files", appDomain)) {
+		Common::SeekableReadStream *stream = PosixMmapStream::makeFromPath(getPath());
+		if (stream)
+			return stream;
+	}
+#endif
 	return StdioStream::makeFromPath(getPath(), false);
 }
 
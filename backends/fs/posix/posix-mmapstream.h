@@ -0,0 +1,64 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef BACKENDS_FS_POSIX_MMAPSTREAM_H
+#define BACKENDS_FS_POSIX_MMAPSTREAM_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+/**
+ * A read stream for a file which is memory mapped instead of being read
+ * through stdio. Reads are plain copies from the mapping, seeking is free,
+ * and getDataPointer() gives direct access to the file contents.
+ *
+ * POSIXFilesystemNode only uses this if the "mmap_files" config key is set.
+ */
+class PosixMmapStream : public Common::MemoryReadStream, public Common::NonCopyable {
+public:
+	/**
+	 * Files smaller than this are left to StdioStream. Mapping them saves
+	 * little, and keeps them safe from being truncated while mapped (which
+	 * would crash the next access with SIGBUS); small files like savegames
+	 * are the ones which get rewritten while ScummVM runs.
+	 */
+	static const int32 kMinimumSize = 1024 * 1024;
+
+	/**
+	 * Given a path, maps the file at that path into memory and wraps the
+	 * mapping in a PosixMmapStream instance.
+	 *
+	 * @return the new stream, or 0 if the file is not a regular file of at
+	 *         least kMinimumSize bytes, or could not be mapped
+	 */
+	static PosixMmapStream *makeFromPath(const Common::String &path);
+
+	virtual ~PosixMmapStream();
+
+private:
+	PosixMmapStream(const byte *data, uint32 size);
+};
+
+#endif
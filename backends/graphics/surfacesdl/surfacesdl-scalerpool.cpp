@@ -0,0 +1,150 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
+
+#include "common/textconsole.h"
+
+SdlScalerPool::SdlScalerPool(int numThreads)
+	: _nextJob(0), _jobMutex(0), _startSem(0), _doneSem(0), _quit(false) {
+
+	_jobMutex = SDL_CreateMutex();
+	_startSem = SDL_CreateSemaphore(0);
+	_doneSem = SDL_CreateSemaphore(0);
+
+	if (!_jobMutex || !_startSem || !_doneSem) {
+		warning("Could not create scaler thread synchronization objects: %s", SDL_GetError());
+		return;
+	}
+
+	for (int i = 1; i < numThreads; ++i) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		SDL_Thread *thread = SDL_CreateThread(workerThread, "ScummVM scaler", this);
+#else
+		SDL_Thread *thread = SDL_CreateThread(workerThread, this);
+#endif
+		if (!thread) {
+			warning("Could not create scaler thread: %s", SDL_GetError());
+			break;
+		}
+
+		_threads.push_back(thread);
+	}
+}
+
+SdlScalerPool::~SdlScalerPool() {
+	_quit = true;
+	for (uint i = 0; i < _threads.size(); ++i)
+		SDL_SemPost(_startSem);
+	for (uint i = 0; i < _threads.size(); ++i)
+		SDL_WaitThread(_threads[i], 0);
+
+	if (_doneSem)
+		SDL_DestroySemaphore(_doneSem);
+	if (_startSem)
+		SDL_DestroySemaphore(_startSem);
+	if (_jobMutex)
+		SDL_DestroyMutex(_jobMutex);
+}
+
+void SdlScalerPool::scale(ScalerProc *scalerProc, const uint8 *srcPtr, uint32 srcPitch,
+                          uint8 *dstPtr, uint32 dstPitch, int width, int height, int scaleFactor) {
+	const int numThreads = _threads.size() + 1;
+
+	// Not worth waking up the workers for small rectangles
+	if (numThreads == 1 || height < 2 * kMinBandHeight) {
+		scalerProc(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		return;
+	}
+
+	int bandHeight = (height + numThreads - 1) / numThreads;
+	bandHeight = (bandHeight + kMinBandHeight - 1) / kMinBandHeight * kMinBandHeight;
+
+	_jobs.clear();
+	for (int y = 0; y < height; y += bandHeight) {
+		Job job;
+		job.scalerProc = scalerProc;
+		job.srcPtr = srcPtr + y * srcPitch;
+		job.srcPitch = srcPitch;
+		job.dstPtr = dstPtr + y * scaleFactor * dstPitch;
+		job.dstPitch = dstPitch;
+		job.width = width;
+		job.height = MIN(bandHeight, height - y);
+
+		// Merge a short remainder into the last band
+		if (height - y - job.height < kMinBandHeight) {
+			job.height = height - y;
+			bandHeight = job.height;
+		}
+
+		_jobs.push_back(job);
+	}
+	_nextJob = 0;
+
+	// Semaphore operations synchronize memory, so the workers see the job
+	// list, and we see the scaled pixels once they are done.
+	const uint numWorkers = MIN<uint>(_threads.size(), _jobs.size() - 1);
+	for (uint i = 0; i < numWorkers; ++i)
+		SDL_SemPost(_startSem);
+
+	while (runNextJob())
+		;
+
+	for (uint i = 0; i < numWorkers; ++i)
+		SDL_SemWait(_doneSem);
+}
+
+bool SdlScalerPool::runNextJob() {
+	SDL_mutexP(_jobMutex);
+	if (_nextJob >= _jobs.size()) {
+		SDL_mutexV(_jobMutex);
+		return false;
+	}
+	const Job job = _jobs[_nextJob++];
+	SDL_mutexV(_jobMutex);
+
+	job.scalerProc(job.srcPtr, job.srcPitch, job.dstPtr, job.dstPitch, job.width, job.height);
+	return true;
+}
+
+int SDLCALL SdlScalerPool::workerThread(void *data) {
+	SdlScalerPool *pool = (SdlScalerPool *)data;
+
+	while (true) {
+		SDL_SemWait(pool->_startSem);
+		if (pool->_quit)
+			break;
+
+		while (pool->runNextJob())
+			;
+
+		SDL_SemPost(pool->_doneSem);
+	}
+
+	return 0;
+}
+
+#endif
@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+#define BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/array.h"
+#include "graphics/scaler.h"
+
+/**
+ * A small pool of SDL threads which run a scaler on horizontal bands of a
+ * rectangle in parallel.
+ *
+ * Every band is scaled into its own destination rows, while the source rows
+ * around it are only read, so bands can be processed independently. The
+ * calling thread takes part in the work and scale() only returns once all
+ * bands are done, so the order of operations on the screen is unchanged.
+ */
+class SdlScalerPool {
+public:
+	/**
+	 * @param numThreads total number of threads to use for scaling,
+	 *                   including the calling thread
+	 */
+	SdlScalerPool(int numThreads);
+	~SdlScalerPool();
+
+	/**
+	 * Scale a rectangle, splitting it into bands if it is big enough.
+	 *
+	 * The parameters are the same as for a ScalerProc, with the addition
+	 * of the scale factor which is needed to find the destination of each
+	 * band.
+	 */
+	void scale(ScalerProc *scalerProc, const uint8 *srcPtr, uint32 srcPitch,
+	           uint8 *dstPtr, uint32 dstPitch, int width, int height, int scaleFactor);
+
+private:
+	enum {
+		/**
+		 * Minimum height of a band. Bands are also kept at a multiple of
+		 * this, so scalers which work on pairs of lines or whose output
+		 * depends on the line number (DotMatrix) are not affected.
+		 */
+		kMinBandHeight = 16
+	};
+
+	struct Job {
+		ScalerProc *scalerProc;
+		const uint8 *srcPtr;
+		uint32 srcPitch;
+		uint8 *dstPtr;
+		uint32 dstPitch;
+		int width;
+		int height;
+	};
+
+	Common::Array<Job> _jobs;
+	uint _nextJob;
+
+	Common::Array<SDL_Thread *> _threads;
+	SDL_mutex *_jobMutex;
+	SDL_sem *_startSem;
+	SDL_sem *_doneSem;
+	bool _quit;
+
+	bool runNextJob();
+	static int SDLCALL workerThread(void *data);
+};
+
+#endif
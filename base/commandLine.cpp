@@ -27,6 +27,8 @@
 
 #include <limits.h>
 
+#include "engines/detectioncache.h"
+#include "engines/gamescanner.h"
 #include "engines/metaengine.h"
 #include "base/commandLine.h"
 #include "base/plugins.h"
@@ -81,6 +83,9 @@ static const char HELP_STRING[] =
 	"                           and start the first one. Use --path=PATH before --auto-detect\n"
 	"                           to specify a directory.\n"
 	"  --recursive              In combination with --add or --detect recurse down all subdirectories\n"
+	"  --no-detection-cache     Compute the checksums of all game files during detection,\n"
+	"                           instead of reusing those cached from earlier runs.\n"
+	"                           Use before --add or --detect\n"
 #if defined(WIN32) && !defined(_WIN32_WCE) && !defined(__SYMBIAN32__)
 	"  --console                Enable the console window (default:enabled)\n"
 #endif
@@ -138,7 +143,9 @@ static const char HELP_STRING[] =
 	"                           atari, macintosh)\n"
 #ifdef ENABLE_EVENTRECORDER
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
-	"                           passthrough [default])\n"
+	"                           benchmark, passthrough [default]). benchmark plays\n"
+	"                           back without display as fast as possible and reports\n"
+	"                           the time the engine spent on each frame\n"
 	"  --record-file-name=FILE  Specify record file name\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
@@ -270,6 +277,7 @@ void registerDefaults() {
 
 	ConfMan.registerDefault("gui_browser_show_hidden", false);
 	ConfMan.registerDefault("game", "");
+	ConfMan.registerDefault("detection_cache", true);
 
 #ifdef USE_FLUIDSYNTH
 	// The settings are deliberately stored the same way as in Qsynth. The
@@ -609,6 +617,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("recursive")
 			END_OPTION
 
+			DO_LONG_OPTION_BOOL("detection-cache")
+			END_OPTION
+
 			DO_LONG_OPTION("themepath")
 				Common::FSNode path(option);
 				if (!path.exists()) {
@@ -806,23 +817,31 @@ static void listAudioDevices() {
 	}
 }
 
-/** Display all games in the given directory, or current directory if empty */
-static GameList getGameList(const Common::FSNode &dir) {
-	Common::FSList files;
+enum {
+	// Interval (in milliseconds) at which progress is reported while scanning
+	// directory trees for games.
+	kScanProgressInterval = 2000
+};
 
-	//Collect all files from directory
-	if (!dir.getChildren(files, Common::FSNode::kListAll)) {
+/**
+ * Detect all games in the given directory, and in all its subdirectories if
+ * requested. Progress is reported while big directory trees are scanned.
+ */
+static GameList scanGames(const Common::FSNode &dir, bool recursive) {
+	if (!dir.isDirectory()) {
 		printf("Path %s does not exist or is not a directory.\n", dir.getPath().c_str());
 		return GameList();
 	}
 
-	// detect Games
-	GameList candidates(EngineMan.detectGames(files));
-	Common::String dataPath = dir.getPath();
-	// add game data path
-	for (GameList::iterator v = candidates.begin(); v != candidates.end(); ++v) {
-		(*v)["path"] = dataPath;
+	GameScanner scanner(dir, recursive);
+	GameList candidates;
+	while (!scanner.scan(kScanProgressInterval)) {
+		candidates.push_back(scanner.takeDetectedGames());
+		printf("Scanned %d of %d directories, found %d games so far...\n",
+				scanner.getDirsScanned(), scanner.getDirsTotal(), candidates.size());
 	}
+	candidates.push_back(scanner.takeDetectedGames());
+
 	return candidates;
 }
 
@@ -852,30 +871,17 @@ static bool addGameToConf(const GameDescriptor &gd) {
 	return true;
 }
 
-static GameList recListGames(const Common::FSNode &dir, const Common::String &gameId, bool recursive) {
-	GameList list = getGameList(dir);
-
-	if (recursive) {
-		Common::FSList files;
-		dir.getChildren(files, Common::FSNode::kListDirectoriesOnly);
-		for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
-			GameList rec = recListGames(*file, gameId, recursive);
-			for (GameList::const_iterator game = rec.begin(); game != rec.end(); ++game) {
-				if (gameId.empty() || game->gameid().c_str() == gameId)
-					list.push_back(*game);
-			}
-		}
-	}
-
-	return list;
-}
-
 /** Display all games in the given directory, return ID of first detected game */
 static Common::String detectGames(const Common::String &path, const Common::String &gameId, bool recursive) {
 	bool noPath = path.empty();
 	//Current directory
 	Common::FSNode dir(path);
-	GameList candidates = recListGames(dir, gameId, recursive);
+	GameList candidates;
+	const GameList games = scanGames(dir, recursive);
+	for (GameList::const_iterator game = games.begin(); game != games.end(); ++game) {
+		if (gameId.empty() || game->gameid() == gameId)
+			candidates.push_back(*game);
+	}
 
 	if (candidates.empty()) {
 		printf("WARNING: ScummVM could not find any game in %s\n", dir.getPath().c_str());
@@ -897,9 +903,11 @@ static Common::String detectGames(const Common::String &path, const Common::Stri
 	return candidates[0].gameid();
 }
 
-static int recAddGames(const Common::FSNode &dir, const Common::String &game, bool recursive) {
-	int count = 0;
-	GameList list = getGameList(dir);
+static bool addGames(const Common::String &path, const Common::String &game, bool recursive) {
+	//Current directory
+	Common::FSNode dir(path);
+	int added = 0;
+	GameList list = scanGames(dir, recursive);
 	for (GameList::iterator v = list.begin(); v != list.end(); ++v) {
 		if (v->gameid().c_str() != game && !game.empty()) {
 			printf("Found %s, only adding %s per --game option, ignoring...\n", v->gameid().c_str(), game.c_str());
@@ -908,26 +916,9 @@ static int recAddGames(const Common::FSNode &dir, const Common::String &game, bo
 			printf("Found %s, but has already been added, skipping\n", v->gameid().c_str());
 		} else {
 			printf("Found %s, adding...\n", v->gameid().c_str());
-			count++;
-		}
-	}
-
-	if (recursive) {
-		Common::FSList files;
-		if (dir.getChildren(files, Common::FSNode::kListDirectoriesOnly)) {
-			for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
-				count += recAddGames(*file, game, recursive);
-			}
+			added++;
 		}
 	}
-
-	return count;
-}
-
-static bool addGames(const Common::String &path, const Common::String &game, bool recursive) {
-	//Current directory
-	Common::FSNode dir(path);
-	int added = recAddGames(dir, game, recursive);
 	printf("Added %d games\n", added);
 	if (added == 0 && !recursive) {
 		printf("Consider using --recursive to search inside subdirectories\n");
@@ -1136,6 +1127,11 @@ bool processSettings(Common::String &command, Common::StringMap &settings, Commo
 
 #ifndef DISABLE_COMMAND_LINE
 
+	// The detection cache option affects the detection commands below, so it
+	// has to be applied before the rest of the settings.
+	if (settings.contains("detection-cache"))
+		ConfMan.set("detection_cache", settings["detection-cache"], Common::ConfigManager::kTransientDomain);
+
 	// Handle commands passed via the command line (like --list-targets and
 	// --list-games). This must be done after the config file and the plugins
 	// have been loaded.
@@ -1175,6 +1171,7 @@ bool processSettings(Common::String &command, Common::StringMap &settings, Commo
 			// Consider removing this if consensus says otherwise.
 		} else {
 			command = detectGames(settings["path"], settings["game"], resursive);
+			DetectionCacheMan.flush();
 			if (command.empty()) {
 				err = Common::kNoGameDataFoundError;
 				return true;
@@ -1182,9 +1179,11 @@ bool processSettings(Common::String &command, Common::StringMap &settings, Commo
 		}
 	} else if (command == "detect") {
 		detectGames(settings["path"], settings["game"], settings["recursive"] == "true");
+		DetectionCacheMan.flush();
 		return true;
 	} else if (command == "add") {
 		addGames(settings["path"], settings["game"], settings["recursive"] == "true");
+		DetectionCacheMan.flush();
 		return true;
 	}
 #ifdef DETECTOR_TESTING_HACK
@@ -530,6 +530,27 @@ GameList EngineManager::detectGames(const Common::FSList &fslist) const {
 	return candidates;
 }
 
+Common::Array<GameList> EngineManager::detectGames(const Common::Array<Common::FSList> &fslists) const {
+	Common::Array<GameList> candidates;
+	candidates.resize(fslists.size());
+	if (fslists.empty())
+		return candidates;
+
+	EnginePlugin::List plugins;
+	EnginePlugin::List::const_iterator iter;
+	PluginManager::instance().loadFirstPlugin();
+	do {
+		plugins = getPlugins();
+		// Let each plugin look at all directories before moving on to the
+		// next one, instead of cycling through all plugins per directory.
+		for (iter = plugins.begin(); iter != plugins.end(); ++iter) {
+			for (uint i = 0; i < fslists.size(); ++i)
+				candidates[i].push_back((**iter)->detectGames(fslists[i]));
+		}
+	} while (PluginManager::instance().loadNextPlugin());
+	return candidates;
+}
+
 const EnginePlugin::List &EngineManager::getPlugins() const {
 	return (const EnginePlugin::List &)PluginManager::instance().getPlugins(PLUGIN_TYPE_ENGINE);
 }
@@ -133,6 +133,11 @@ int32 File::size() const {
 	return _handle->size();
 }
 
+const byte *File::getDataPointer() const {
+	assert(_handle);
+	return _handle->getDataPointer();
+}
+
 bool File::seek(int32 offs, int whence) {
 	assert(_handle);
 	return _handle->seek(offs, whence);
@@ -0,0 +1,591 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+// The open addressing scheme used in this file follows the "Swiss table"
+// design: slots are grouped in runs of 16, and each slot has a one byte
+// control code which allows a whole group to be probed at once.
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/endian.h"
+#include "common/func.h"
+#include "common/math.h"
+
+#if defined(__SSE2__)
+#define FLATHASHMAP_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Common {
+
+/**
+ * FlatHashMap<Key,Val> maps objects of type Key to objects of type Val.
+ *
+ * It offers the same interface as HashMap and uses the same hash and
+ * equality functors, but stores its keys and values inline in a single
+ * array instead of allocating a node per entry. Lookups therefore do not
+ * need to chase a pointer for every probed slot, and iterating over the
+ * map walks memory linearly.
+ *
+ * Every slot is accompanied by a control byte which is either empty,
+ * deleted or holds seven bits of the hash of the key stored in the slot.
+ * Lookups compare a whole group of control bytes at a time (using SSE2
+ * where available), so the key itself is only compared for slots which
+ * are very likely to hold it.
+ *
+ * Empty slots are left unconstructed, so Key need not be default
+ * constructible. Val must be, just like for HashMap: new entries start out
+ * with a value initialized Val, and the const getVal returns a default
+ * constructed one for missing keys.
+ *
+ * Unlike HashMap, entries may be moved when the map grows: pointers and
+ * references to values stored in the map are invalidated by every
+ * insertion of a new key. Iterators are invalidated in the same way, but
+ * erasing an entry does not affect iterators pointing to other entries.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	struct Node {
+		const Key _key;
+		Val _value;
+		explicit Node(const Key &key) : _key(key), _value() {}
+	};
+
+	enum {
+		FLATHASHMAP_GROUP_SIZE = 16,
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage may fill up (counting deleted entries) before
+		// it is rehashed.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8
+	};
+
+	enum {
+		kCtrlEmpty = 0x80,
+		kCtrlDeleted = 0xFE
+	};
+
+	byte *_ctrl;		///< control bytes, one per slot
+	Node *_slots;		///< raw storage for the entries; only full slots are constructed
+	size_type _mask;	///< Capacity of the map minus one; capacity is a power of two and at least one group
+	size_type _size;
+	size_type _deleted;	///< Number of slots marked as deleted
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/** Default value, returned by the const getVal. */
+	const Val _defaultVal;
+
+	static bool isFull(byte ctrl) {
+		return !(ctrl & 0x80);
+	}
+
+	/**
+	 * Spread the bits of the hash value. Many of our hash functors (e.g. the
+	 * one for integers) are the identity function, but the upper bits are
+	 * used as the control byte and the lower bits select the group. A plain
+	 * multiplication is not enough: its low bits only depend on the low bits
+	 * of the hash, so keys with a power of two stride end up in very few
+	 * groups. Hence this uses the MurmurHash3 finalizer, which makes every
+	 * bit of the result depend on all bits of the input.
+	 */
+	static size_type mixHash(size_type hash) {
+		uint32 h = hash;
+		h ^= h >> 16;
+		h *= 0x85EBCA6B;
+		h ^= h >> 13;
+		h *= 0xC2B2AE35;
+		h ^= h >> 16;
+		return h;
+	}
+
+	static byte hashToCtrl(size_type mixed) {
+		return (byte)((mixed >> 25) & 0x7F);
+	}
+
+	/** Returns a bitmask of all slots in the group whose control byte equals value. */
+	static uint32 matchGroup(const byte *group, byte value) {
+#ifdef FLATHASHMAP_USE_SSE2
+		const __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+		return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)value)));
+#else
+		// Look at four control bytes at a time: a byte of v is zero exactly
+		// if the control byte matches.
+		uint32 mask = 0;
+		for (int i = 0; i < FLATHASHMAP_GROUP_SIZE; i += 4) {
+			const uint32 v = READ_LE_UINT32(group + i) ^ (0x01010101 * value);
+			mask |= compressMask(~(((v & 0x7F7F7F7F) + 0x7F7F7F7F) | v | 0x7F7F7F7F)) << i;
+		}
+		return mask;
+#endif
+	}
+
+	/** Returns a bitmask of all slots in the group which are either empty or deleted. */
+	static uint32 matchFree(const byte *group) {
+#ifdef FLATHASHMAP_USE_SSE2
+		return (uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+		uint32 mask = 0;
+		for (int i = 0; i < FLATHASHMAP_GROUP_SIZE; i += 4)
+			mask |= compressMask(READ_LE_UINT32(group + i) & 0x80808080) << i;
+		return mask;
+#endif
+	}
+
+#ifndef FLATHASHMAP_USE_SSE2
+	/** Gathers the top bits of the four bytes of v (and nothing else) into the lowest four bits. */
+	static uint32 compressMask(uint32 v) {
+		return (((v >> 7) * 0x00204081) >> 21) & 0xF;
+	}
+#endif
+
+	static int lowestBit(uint32 mask) {
+		return intLog2(mask & (~mask + 1));
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key, size_type mixed) const;
+	size_type findFreeSlot(size_type mixed) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rehash(size_type newCapacity);
+	void eraseSlot(size_type idx);
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != 0);
+			assert(_idx <= _hashmap->_mask);
+			assert(isFull(_hashmap->_ctrl[_idx]));
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(0) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextFull(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	/** Returns the index of the first full slot at or after idx, or (size_type)-1. */
+	size_type nextFull(size_type idx) const {
+		for (; idx <= _mask; ++idx) {
+			if (isFull(_ctrl[idx]))
+				return idx;
+		}
+		return (size_type)-1;
+	}
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getVal(const Key &key, const Val &defaultVal) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		return iterator(nextFull(0), this);
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		return const_iterator(nextFull(0), this);
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		const size_type ctr = lookup(key, mixHash(_hash(key)));
+		if (ctr <= _mask)
+			return iterator(ctr, this);
+		return end();
+	}
+
+	const_iterator	find(const Key &key) const {
+		const size_type ctr = lookup(key, mixHash(_hash(key)));
+		if (ctr <= _mask)
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	_size = 0;
+	_deleted = 0;
+}
+
+/**
+ * Copy constructor, creates a full copy of the given map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) :
+	_defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	assert(capacity >= FLATHASHMAP_MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+	_mask = capacity - 1;
+	_ctrl = new byte[capacity];
+	assert(_ctrl != NULL);
+	memset(_ctrl, kCtrlEmpty, capacity);
+	_slots = (Node *)malloc(capacity * sizeof(Node));
+	assert(_slots != NULL);
+}
+
+/**
+ * Frees the internal storage. All entries must have been destroyed before.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	delete[] _ctrl;
+	free(_slots);
+	_ctrl = NULL;
+	_slots = NULL;
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The layout of the other map is valid for this one as well, so
+	// simply clone it slot by slot.
+	memcpy(_ctrl, map._ctrl, _mask + 1);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(_ctrl[ctr])) {
+			new (&_slots[ctr]) Node(map._slots[ctr]._key);
+			_slots[ctr]._value = map._slots[ctr]._value;
+		}
+	}
+	_size = map._size;
+	_deleted = map._deleted;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(_ctrl[ctr]))
+			_slots[ctr].~Node();
+	}
+
+	if (shrinkArray && _mask + 1 > FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		memset(_ctrl, kCtrlEmpty, _mask + 1);
+	}
+
+	_size = 0;
+	_deleted = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity >= _mask + 1);
+
+	const size_type old_mask = _mask;
+	byte *old_ctrl = _ctrl;
+	Node *old_slots = _slots;
+
+	allocStorage(newCapacity);
+
+	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
+		if (!isFull(old_ctrl[ctr]))
+			continue;
+
+		// No key exists twice in the old table, so there is no need to
+		// call _equal(); just put the entry into the first free slot.
+		const size_type mixed = mixHash(_hash(old_slots[ctr]._key));
+		const size_type idx = findFreeSlot(mixed);
+		_ctrl[idx] = hashToCtrl(mixed);
+		new (&_slots[idx]) Node(old_slots[ctr]._key);
+		_slots[idx]._value = old_slots[ctr]._value;
+		old_slots[ctr].~Node();
+	}
+
+	_deleted = 0;
+
+	delete[] old_ctrl;
+	free(old_slots);
+}
+
+/**
+ * Returns the index of the slot holding the given key, or _mask + 1 if the
+ * key is not contained in the map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key, size_type mixed) const {
+	const byte h2 = hashToCtrl(mixed);
+	const size_type groupMask = (_mask + 1) / FLATHASHMAP_GROUP_SIZE - 1;
+	size_type group = mixed & groupMask;
+
+	// Triangular probing visits every group exactly once, since the number
+	// of groups is a power of two. The load factor guarantees that there is
+	// an empty slot somewhere, so this terminates.
+	for (size_type step = 1; ; ++step) {
+		const byte *ctrl = _ctrl + group * FLATHASHMAP_GROUP_SIZE;
+		for (uint32 match = matchGroup(ctrl, h2); match; match &= match - 1) {
+			const size_type idx = group * FLATHASHMAP_GROUP_SIZE + lowestBit(match);
+			if (_equal(_slots[idx]._key, key))
+				return idx;
+		}
+
+		// A group with an empty slot ends the probe sequence: the key would
+		// have been inserted there.
+		if (matchGroup(ctrl, kCtrlEmpty))
+			return _mask + 1;
+
+		group = (group + step) & groupMask;
+	}
+}
+
+/**
+ * Returns the index of the first empty or deleted slot in the probe
+ * sequence of the given hash.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findFreeSlot(size_type mixed) const {
+	const size_type groupMask = (_mask + 1) / FLATHASHMAP_GROUP_SIZE - 1;
+	size_type group = mixed & groupMask;
+
+	for (size_type step = 1; ; ++step) {
+		const uint32 match = matchFree(_ctrl + group * FLATHASHMAP_GROUP_SIZE);
+		if (match)
+			return group * FLATHASHMAP_GROUP_SIZE + lowestBit(match);
+
+		group = (group + step) & groupMask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const size_type mixed = mixHash(_hash(key));
+	size_type ctr = lookup(key, mixed);
+	if (ctr <= _mask)
+		return ctr;
+
+	// Keep the load factor below a certain threshold. Deleted slots are
+	// also counted, since they lengthen probe sequences just the same.
+	// If the map is mostly filled with deleted slots, rehashing at the
+	// current size is enough to get rid of them.
+	size_type capacity = _mask + 1;
+	if ((_size + _deleted + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		if ((_size + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR * 2 > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+			capacity *= 2;
+		rehash(capacity);
+	}
+
+	ctr = findFreeSlot(mixed);
+	if (_ctrl[ctr] == kCtrlDeleted)
+		_deleted--;
+	_ctrl[ctr] = hashToCtrl(mixed);
+	new (&_slots[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type idx) {
+	_slots[idx].~Node();
+	_size--;
+
+	// Probing stops at the first group with an empty slot. If the group of
+	// the erased slot already has one, no probe sequence continues past this
+	// group and the slot can be marked as empty right away.
+	if (matchGroup(_ctrl + (idx & ~(size_type)(FLATHASHMAP_GROUP_SIZE - 1)), kCtrlEmpty)) {
+		_ctrl[idx] = kCtrlEmpty;
+	} else {
+		_ctrl[idx] = kCtrlDeleted;
+		_deleted++;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key, mixHash(_hash(key))) <= _mask;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	return getVal(key, _defaultVal);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key, const Val &defaultVal) const {
+	const size_type ctr = lookup(key, mixHash(_hash(key)));
+	if (ctr <= _mask)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	assert(entry._idx <= _mask);
+	assert(isFull(_ctrl[entry._idx]));
+
+	eraseSlot(entry._idx);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	const size_type ctr = lookup(key, mixHash(_hash(key)));
+	if (ctr <= _mask)
+		eraseSlot(ctr);
+}
+
+} // End of namespace Common
+
+#endif
@@ -213,6 +213,18 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Retrieves the size and the time of the last modification of the file
+	 * referred by this node, without opening it. This is not supported by
+	 * all backends, and never for directories.
+	 *
+	 * The modification time is only meant to be compared against earlier
+	 * values obtained for the same file, e.g. to validate cached data.
+	 *
+	 * @return true if the information is available, false otherwise.
+	 */
+	bool getFileInfo(uint32 &size, uint32 &modificationTime) const;
+
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -280,16 +280,59 @@ bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length) {
 	return true;
 }
 
-String computeStreamMD5AsString(ReadStream &stream, uint32 length) {
+bool computeStreamMD5(SeekableReadStream &stream, uint8 digest[16], uint32 length) {
+	const byte *data = stream.getDataPointer();
+	if (!data)
+		return computeStreamMD5((ReadStream &)stream, digest, length);
+
+#ifdef DISABLE_MD5
+	memset(digest, 0, 16);
+#else
+	const int32 pos = stream.pos();
+	const uint32 available = stream.size() - pos;
+	const bool toEnd = (length == 0 || length > available);
+	if (toEnd)
+		length = available;
+
+	md5_context ctx;
+	md5_starts(&ctx);
+	md5_update(&ctx, data + pos, length);
+	md5_finish(&ctx, digest);
+
+	// Leave the stream where reading it would have left it. Reading up to
+	// the end of the data also sets the end of stream flag.
+	stream.seek(pos + length);
+	if (toEnd) {
+		byte dummy;
+		stream.read(&dummy, 1);
+	}
+#endif
+	return true;
+}
+
+static String digestToString(const uint8 digest[16]) {
 	String md5;
-	uint8 digest[16];
-	if (computeStreamMD5(stream, digest, length)) {
-		for (int i = 0; i < 16; i++) {
-			md5 += String::format("%02x", (int)digest[i]);
-		}
+	for (int i = 0; i < 16; i++) {
+		md5 += String::format("%02x", (int)digest[i]);
 	}
 
 	return md5;
 }
 
+String computeStreamMD5AsString(ReadStream &stream, uint32 length) {
+	uint8 digest[16];
+	if (computeStreamMD5(stream, digest, length))
+		return digestToString(digest);
+
+	return String();
+}
+
+String computeStreamMD5AsString(SeekableReadStream &stream, uint32 length) {
+	uint8 digest[16];
+	if (computeStreamMD5(stream, digest, length))
+		return digestToString(digest);
+
+	return String();
+}
+
 } // End of namespace Common
@@ -28,6 +28,7 @@
 namespace Common {
 
 class ReadStream;
+class SeekableReadStream;
 class String;
 
 /**
@@ -42,6 +43,14 @@ class String;
  */
 bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length = 0);
 
+/**
+ * Compute the MD5 checksum of the content of the given SeekableReadStream,
+ * starting at its current position. This behaves like the ReadStream
+ * variant, but hashes the data in place if the stream supports
+ * SeekableReadStream::getDataPointer().
+ */
+bool computeStreamMD5(SeekableReadStream &stream, uint8 digest[16], uint32 length = 0);
+
 /**
  * Compute the MD5 checksum of the content of the given ReadStream.
  * The 128 bit MD5 checksum is converted to a human readable
@@ -54,6 +63,13 @@ bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length = 0);
  */
 String computeStreamMD5AsString(ReadStream &stream, uint32 length = 0);
 
+/**
+ * Compute the MD5 checksum of the content of the given SeekableReadStream,
+ * as a human readable string.
+ * @see computeStreamMD5(SeekableReadStream &, uint8 *, uint32)
+ */
+String computeStreamMD5AsString(SeekableReadStream &stream, uint32 length = 0);
+
 } // End of namespace Common
 
 #endif
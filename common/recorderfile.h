@@ -124,6 +124,11 @@ public:
 	Graphics::Surface *getScreenShot(int number);
 	int getScreensCount();
 
+	/** Number of recorded screenshots compared with the screen during playback. */
+	uint32 getCheckedScreenshotsCount() const { return _checkedScreenshots; }
+	/** Number of recorded screenshots which differed from the screen during playback. */
+	uint32 getFailedScreenshotsCount() const { return _failedScreenshots; }
+
 	bool isEventsBufferEmpty();
 	PlaybackFileHeader &getHeader() {return _header;}
 	void updateHeader();
@@ -143,6 +148,8 @@ private:
 	byte _tmpBuffer[kRecordBuffSize];
 	PlaybackFileHeader _header;
 	PlaybackFileState _playbackParseState;
+	uint32 _checkedScreenshots;
+	uint32 _failedScreenshots;
 
 	void skipHeader();
 	bool parseHeader();
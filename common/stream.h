@@ -511,6 +511,18 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Returns a pointer to the complete contents of the stream, for streams
+	 * which keep their data in memory anyway (e.g. memory streams and
+	 * memory mapped files). This allows accessing the data without copying
+	 * it. The pointer is only valid for as long as the stream exists, and
+	 * using it does not affect the stream position.
+	 *
+	 * @return a pointer to size() bytes of data, or 0 if the stream does not
+	 *         support direct access; the data then has to be read instead
+	 */
+	virtual const byte *getDataPointer() const { return 0; }
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
@@ -153,6 +153,10 @@ Common::String OSystem::getSystemLanguage() const {
 	return "en_US";
 }
 
+uint64 OSystem::getMicros() {
+	return (uint64)getMillis(true) * 1000;
+}
+
 Common::TimerManager *OSystem::getTimerManager() {
 	return _timerManager;
 }
@@ -994,6 +994,16 @@ public:
 	*/
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get the number of microseconds since an arbitrary point in time, for
+	 * profiling. Unlike getMillis(), this always returns the real time,
+	 * also while the event recorder plays back or records a session.
+	 *
+	 * The default implementation is based on getMillis(), so it has a
+	 * resolution of one millisecond and follows the event recorder's timer.
+	 */
+	virtual uint64 getMicros();
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -0,0 +1,123 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a micro benchmark comparing Common::HashMap and
+ * Common::FlatHashMap for integer and string keys.
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include <stdio.h>
+#include <time.h>
+
+#include "common/scummsys.h"
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+
+enum {
+	kNumKeys = 100000,
+	kLookupRounds = 10
+};
+
+static double seconds(clock_t start) {
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Builds a map from the given keys, then looks every key up and iterates
+ * over the map kLookupRounds times, and finally erases half of the keys.
+ * The timings are summed up over the given number of rounds.
+ */
+template<class Map, class Key>
+static void benchmark(const char *name, const Key *keys, int numKeys, int rounds) {
+	double build = 0, lookup = 0, iterate = 0, erase = 0;
+	uint sink = 0;
+
+	for (int round = 0; round < rounds; ++round) {
+		Map map;
+
+		clock_t start = clock();
+		for (int i = 0; i < numKeys; ++i)
+			map[keys[i]] = i;
+		build += seconds(start);
+
+		start = clock();
+		for (int j = 0; j < kLookupRounds; ++j) {
+			for (int i = 0; i < numKeys; ++i)
+				sink += map.getVal(keys[(i * 7919) % numKeys]) + map.contains(keys[i]);
+		}
+		lookup += seconds(start);
+
+		start = clock();
+		for (int j = 0; j < kLookupRounds; ++j) {
+			for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it)
+				sink += it->_value;
+		}
+		iterate += seconds(start);
+
+		start = clock();
+		for (int i = 0; i < numKeys; i += 2)
+			map.erase(keys[i]);
+		erase += seconds(start);
+	}
+
+	// Print the sink, so the compiler cannot drop the lookups
+	printf("%-22s build %6.3fs  lookup %6.3fs  iterate %6.3fs  erase %6.3fs  (%08x)\n",
+	       name, build, lookup, iterate, erase, sink);
+}
+
+int main(int argc, char *argv[]) {
+	uint *randomKeys = new uint[kNumKeys];
+	uint *stridedKeys = new uint[kNumKeys];
+	Common::String *stringKeys = new Common::String[kNumKeys];
+
+	uint seed = 1;
+	for (int i = 0; i < kNumKeys; ++i) {
+		seed = seed * 1103515245 + 12345;
+		randomKeys[i] = seed ^ (seed >> 13);
+		// Keys with a power of two stride, e.g. addresses or resource offsets
+		stridedKeys[i] = (uint)i << 12;
+		stringKeys[i] = Common::String::format("data/dir%d/file%05d.dat", i % 17, i);
+	}
+
+	printf("%d keys, times summed over all rounds\n\n", kNumKeys);
+
+	benchmark<Common::HashMap<uint, uint> >("HashMap<random>", randomKeys, kNumKeys, 10);
+	benchmark<Common::FlatHashMap<uint, uint> >("FlatHashMap<random>", randomKeys, kNumKeys, 10);
+	benchmark<Common::HashMap<uint, uint> >("HashMap<strided>", stridedKeys, kNumKeys, 10);
+	benchmark<Common::FlatHashMap<uint, uint> >("FlatHashMap<strided>", stridedKeys, kNumKeys, 10);
+	benchmark<Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("HashMap<String>", stringKeys, kNumKeys, 5);
+	benchmark<Common::FlatHashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("FlatHashMap<String>", stringKeys, kNumKeys, 5);
+
+	delete[] randomKeys;
+	delete[] stridedKeys;
+	delete[] stringKeys;
+
+	return 0;
+}
@@ -0,0 +1,13 @@
+MODULE := devtools/bench_hashmap
+
+MODULE_OBJS := \
+	bench_hashmap.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := bench_hashmap
+
+# Link against the common code, which the benchmarked classes live in
+TOOL_DEPS := common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
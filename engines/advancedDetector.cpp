@@ -31,6 +31,7 @@
 #include "common/translation.h"
 #include "gui/EventRecorder.h"
 #include "engines/advancedDetector.h"
+#include "engines/detectioncache.h"
 #include "engines/obsolete.h"
 
 static GameDescriptor toGameDescriptor(const ADGameDescription &g, const PlainGameDescriptor *sg) {
@@ -266,6 +267,9 @@ Common::Error AdvancedMetaEngine::createInstance(OSystem *syst, Engine **engine)
 	// Run the detector on this
 	ADGameDescList matches = detectGame(files.begin()->getParent(), allFiles, language, platform, extra);
 
+	// Write back anything new before the engine takes over
+	DetectionCacheMan.flush();
+
 	if (cleanupPirated(matches))
 		return Common::kNoGameDataFoundError;
 
@@ -418,13 +422,18 @@ bool AdvancedMetaEngine::getFileProperties(const Common::FSNode &parent, const F
 	if (!allFiles.contains(fname))
 		return false;
 
+	const Common::FSNode &node = allFiles[fname];
+	if (DetectionCacheMan.lookup(node, _md5Bytes, fileProps.size, fileProps.md5))
+		return true;
+
 	Common::File testFile;
 
-	if (!testFile.open(allFiles[fname]))
+	if (!testFile.open(node))
 		return false;
 
 	fileProps.size = (int32)testFile.size();
 	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+	DetectionCacheMan.store(node, _md5Bytes, fileProps.size, fileProps.md5);
 	return true;
 }
 
@@ -0,0 +1,209 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "engines/detectioncache.h"
+
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/fs.h"
+#include "common/stream.h"
+#include "common/textconsole.h"
+
+namespace Common {
+DECLARE_SINGLETON(DetectionCache);
+}
+
+namespace {
+
+const char *const kCacheFileName = "detection.cache";
+const char *const kCacheHeader = "ScummVM detection cache 1";
+
+enum {
+	/**
+	 * Upper bound for the number of entries kept on disk. Entries which were
+	 * not needed during the current session are dropped first, which takes
+	 * care of games which have been removed or moved in the meantime.
+	 */
+	kMaxEntries = 65536
+};
+
+} // End of anonymous namespace
+
+DetectionCache::DetectionCache() : _loaded(false), _dirty(false) {
+}
+
+DetectionCache::~DetectionCache() {
+	flush();
+}
+
+bool DetectionCache::isEnabled() const {
+	return ConfMan.getBool("detection_cache");
+}
+
+Common::String DetectionCache::makeKey(const Common::String &path, uint md5Bytes) {
+	return Common::String::format("%u:", md5Bytes) + path;
+}
+
+void DetectionCache::load() {
+	_loaded = true;
+
+	// The cache is kept next to the saved games. Use the global save path
+	// (unless overridden on the command line), so that the same cache is
+	// found when a game with a custom save path is started.
+	const char *const domain = ConfMan.hasKey("savepath", Common::ConfigManager::kTransientDomain) ?
+		Common::ConfigManager::kTransientDomain : Common::ConfigManager::kApplicationDomain;
+	const Common::String savePath = ConfMan.get("savepath", domain);
+	if (savePath.empty())
+		return;
+
+	Common::FSNode dir(savePath);
+	if (!dir.isDirectory())
+		return;
+
+	Common::FSNode file = dir.getChild(kCacheFileName);
+	_cachePath = file.getPath();
+	if (!file.exists())
+		return;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return;
+
+	if (stream->readLine() != kCacheHeader) {
+		debug(2, "DetectionCache: Ignoring '%s' of unknown version", _cachePath.c_str());
+		delete stream;
+		return;
+	}
+
+	// Every line describes one file as follows:
+	// <md5Bytes> <fileSize> <modificationTime> <size> <md5> <path>
+	// The path comes last, since it may contain spaces.
+	while (!stream->eos() && !stream->err()) {
+		const Common::String line = stream->readLine();
+		if (line.empty())
+			continue;
+
+		uint md5Bytes;
+		Entry entry;
+		char md5[33];
+		int pathOffset = 0;
+		if (sscanf(line.c_str(), "%u %u %u %d %32s %n", &md5Bytes, &entry.fileSize, &entry.modificationTime, &entry.size, md5, &pathOffset) < 5 || pathOffset == 0) {
+			warning("DetectionCache: Skipping malformed entry '%s'", line.c_str());
+			continue;
+		}
+
+		entry.md5 = md5;
+		_entries[makeKey(line.c_str() + pathOffset, md5Bytes)] = entry;
+	}
+
+	delete stream;
+
+	debug(2, "DetectionCache: Loaded %d entries from '%s'", _entries.size(), _cachePath.c_str());
+}
+
+bool DetectionCache::lookup(const Common::FSNode &node, uint md5Bytes, int32 &size, Common::String &md5) {
+	if (!isEnabled())
+		return false;
+
+	if (!_loaded)
+		load();
+
+	uint32 fileSize, modificationTime;
+	if (!node.getFileInfo(fileSize, modificationTime))
+		return false;
+
+	const Common::String key = makeKey(node.getPath(), md5Bytes);
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end())
+		return false;
+
+	Entry &entry = i->_value;
+	if (entry.fileSize != fileSize || entry.modificationTime != modificationTime) {
+		// The file has changed since it was hashed
+		_entries.erase(i);
+		_dirty = true;
+		return false;
+	}
+
+	entry.used = true;
+	size = entry.size;
+	md5 = entry.md5;
+	return true;
+}
+
+void DetectionCache::store(const Common::FSNode &node, uint md5Bytes, int32 size, const Common::String &md5) {
+	if (!isEnabled())
+		return;
+
+	if (!_loaded)
+		load();
+
+	Entry entry;
+	if (!node.getFileInfo(entry.fileSize, entry.modificationTime))
+		return;
+
+	entry.size = size;
+	entry.md5 = md5;
+	entry.used = true;
+	_entries[makeKey(node.getPath(), md5Bytes)] = entry;
+	_dirty = true;
+}
+
+void DetectionCache::flush() {
+	if (!_dirty || _cachePath.empty())
+		return;
+
+	_dirty = false;
+
+	Common::WriteStream *stream = Common::FSNode(_cachePath).createWriteStream();
+	if (!stream) {
+		warning("DetectionCache: Could not write '%s'", _cachePath.c_str());
+		return;
+	}
+
+	stream->writeString(kCacheHeader);
+	stream->writeByte('\n');
+
+	uint written = 0;
+	for (int pass = 0; pass < 2; ++pass) {
+		// Write the entries used in this session first, so they survive
+		// when the cache has grown too big.
+		for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end() && written < kMaxEntries; ++i) {
+			const Entry &entry = i->_value;
+			if (entry.used != (pass == 0))
+				continue;
+
+			const char *path = strchr(i->_key.c_str(), ':') + 1;
+			const uint md5Bytes = atoi(i->_key.c_str());
+			stream->writeString(Common::String::format("%u %u %u %d %s %s\n", md5Bytes, entry.fileSize, entry.modificationTime, entry.size, entry.md5.c_str(), path));
+			++written;
+		}
+	}
+
+	stream->finalize();
+	if (stream->err())
+		warning("DetectionCache: Error while writing '%s'", _cachePath.c_str());
+	delete stream;
+
+	debug(2, "DetectionCache: Wrote %d entries to '%s'", written, _cachePath.c_str());
+}
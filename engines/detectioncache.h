@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef ENGINES_DETECTIONCACHE_H
+#define ENGINES_DETECTIONCACHE_H
+
+#include "common/flathashmap.h"
+#include "common/hash-str.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Common {
+class FSNode;
+}
+
+/**
+ * Persistent cache for the file properties computed during game detection.
+ *
+ * Computing the MD5 of the beginning of every candidate file is what makes
+ * detection slow on big game collections: every engine does it for every
+ * directory, each time the launcher runs detection or mass add. The cache
+ * remembers the results per file path and number of hashed bytes, together
+ * with the size and modification time of the file at the time. A cached
+ * entry is only used as long as both still match, so modified files are
+ * hashed again automatically.
+ *
+ * Files for which the backend cannot report the size and modification time
+ * are never cached. The cache can be disabled with the "detection_cache"
+ * config key (or the --no-detection-cache command line option).
+ */
+class DetectionCache : public Common::Singleton<DetectionCache> {
+public:
+	/**
+	 * Look up the properties of a file.
+	 *
+	 * @param node		the file
+	 * @param md5Bytes	the number of bytes the MD5 is computed over
+	 * @param size		set to the cached file size
+	 * @param md5		set to the cached MD5
+	 * @return true if a valid entry was found, false otherwise
+	 */
+	bool lookup(const Common::FSNode &node, uint md5Bytes, int32 &size, Common::String &md5);
+
+	/**
+	 * Store the properties of a file, as computed by the caller.
+	 */
+	void store(const Common::FSNode &node, uint md5Bytes, int32 size, const Common::String &md5);
+
+	/**
+	 * Write the cache to disk, if it was changed since it was loaded or
+	 * last written.
+	 */
+	void flush();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	DetectionCache();
+	~DetectionCache();
+
+	struct Entry {
+		Entry() : fileSize(0), modificationTime(0), size(0), used(false) {}
+
+		uint32 fileSize;
+		uint32 modificationTime;
+		int32 size;
+		Common::String md5;
+		bool used; ///< whether the entry was looked up or stored this session
+	};
+
+	typedef Common::FlatHashMap<Common::String, Entry> EntryMap;
+
+	bool isEnabled() const;
+	void load();
+	static Common::String makeKey(const Common::String &path, uint md5Bytes);
+
+	EntryMap _entries;
+	Common::String _cachePath;
+	bool _loaded;
+	bool _dirty;
+};
+
+/** Shortcut for accessing the detection cache. */
+#define DetectionCacheMan	DetectionCache::instance()
+
+#endif
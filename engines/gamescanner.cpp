@@ -0,0 +1,89 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#include "engines/gamescanner.h"
+#include "engines/metaengine.h"
+
+#include "common/system.h"
+
+GameScanner::GameScanner(const Common::FSNode &startDir, bool recursive)
+	: _recursive(recursive), _dirsScanned(0) {
+	_scanQueue.push(startDir);
+}
+
+bool GameScanner::scan(uint32 maxTime) {
+	const uint32 startTime = g_system->getMillis();
+
+	while (!_scanQueue.empty()) {
+		Common::Array<Common::FSList> batch;
+		Common::Array<Common::String> paths;
+
+		while (!_scanQueue.empty() && batch.size() < kScanBatchSize) {
+			Common::FSNode dir = _scanQueue.pop();
+			_dirsScanned++;
+
+			Common::FSList files;
+			if (!dir.getChildren(files, Common::FSNode::kListAll))
+				continue;
+
+			if (_recursive) {
+				for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
+					if (file->isDirectory())
+						_scanQueue.push(*file);
+				}
+			}
+
+			Common::String path = dir.getPath();
+
+			// Remove trailing slashes, so that "/foo" and "/foo/" match.
+			// This works around a bug in the POSIX FS code (and others?)
+			// where paths are not normalized.
+			while (path != "/" && path.lastChar() == '/')
+				path.deleteLastChar();
+
+			batch.push_back(files);
+			paths.push_back(path);
+		}
+
+		// Run the detector on the batch
+		const Common::Array<GameList> candidates = EngineMan.detectGames(batch);
+		for (uint i = 0; i < candidates.size(); ++i) {
+			for (GameList::const_iterator cand = candidates[i].begin(); cand != candidates[i].end(); ++cand) {
+				GameDescriptor result = *cand;
+				result["path"] = paths[i];
+				_detectedGames.push_back(result);
+			}
+		}
+
+		if (maxTime && g_system->getMillis() - startTime >= maxTime)
+			break;
+	}
+
+	return isFinished();
+}
+
+GameList GameScanner::takeDetectedGames() {
+	GameList games(_detectedGames);
+	_detectedGames.clear();
+	return games;
+}
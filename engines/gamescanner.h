@@ -0,0 +1,88 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+
+#ifndef ENGINES_GAMESCANNER_H
+#define ENGINES_GAMESCANNER_H
+
+#include "common/fs.h"
+#include "common/queue.h"
+
+#include "engines/game.h"
+
+/**
+ * Searches a directory tree for games, one slice of work at a time.
+ *
+ * This is what the mass add dialog and the --add/--detect command line
+ * options use. Directories are visited breadth-first and passed to the
+ * detector in batches, so that each engine plugin looks at a whole batch
+ * of directories at once.
+ *
+ * Scanning is done incrementally by calling scan() with a time budget;
+ * this allows the GUI to stay responsive and to show progress while big
+ * collections are scanned.
+ */
+class GameScanner {
+public:
+	/**
+	 * @param startDir	the directory to start the scan at
+	 * @param recursive	whether to descend into subdirectories
+	 */
+	GameScanner(const Common::FSNode &startDir, bool recursive);
+
+	/**
+	 * Scan more directories.
+	 *
+	 * @param maxTime	stop scanning after this many milliseconds; the
+	 *                  current batch of directories is always finished.
+	 *                  If 0, scan until done.
+	 * @return true if the scan is complete
+	 */
+	bool scan(uint32 maxTime = 0);
+
+	bool isFinished() const { return _scanQueue.empty(); }
+
+	/** The number of directories scanned so far. */
+	uint getDirsScanned() const { return _dirsScanned; }
+
+	/** The number of directories found so far, scanned or not. */
+	uint getDirsTotal() const { return _dirsScanned + _scanQueue.size(); }
+
+	/**
+	 * Return the games detected since the last call. The "path" key of each
+	 * descriptor is set to the directory the game was detected in.
+	 */
+	GameList takeDetectedGames();
+
+private:
+	enum {
+		/** How many directories are passed to the detector at once. */
+		kScanBatchSize = 8
+	};
+
+	Common::Queue<Common::FSNode> _scanQueue;
+	GameList _detectedGames;
+	const bool _recursive;
+	uint _dirsScanned;
+};
+
+#endif
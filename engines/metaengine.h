@@ -275,6 +275,18 @@ public:
 	GameDescriptor findGameInLoadedPlugins(const Common::String &gameName, const EnginePlugin **plugin = NULL) const;
 	GameDescriptor findGame(const Common::String &gameName, const EnginePlugin **plugin = NULL) const;
 	GameList detectGames(const Common::FSList &fslist) const;
+
+	/**
+	 * Run the detection on the contents of several directories at once.
+	 * The result for each directory is the same as the one of the single
+	 * directory variant, but every engine plugin is only loaded (if plugins
+	 * are loaded one at a time) and invoked for the whole batch at once.
+	 *
+	 * @param fslists	the contents of each directory
+	 * @return the detected games, in the same order as fslists
+	 */
+	Common::Array<GameList> detectGames(const Common::Array<Common::FSList> &fslists) const;
+
 	const EnginePlugin::List &getPlugins() const;
 };
 
@@ -22,6 +22,7 @@
 
 // Console module
 
+#include "common/algorithm.h"
 #include "common/md5.h"
 #include "sci/sci.h"
 #include "sci/console.h"
@@ -54,6 +55,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -117,6 +119,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -150,6 +153,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -225,6 +229,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("vm_profile",			WRAP_METHOD(Console, cmdVMProfile));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -256,6 +261,9 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+	_debugState.profiling = false;
+	_debugState._currentProfile = NULL;
+	_debugState._profileTimestamp = 0;
 }
 
 Console::~Console() {
@@ -375,6 +383,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache - Shows or changes the resource cache policy, budget and statistics\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -404,6 +413,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" cel_cache - Shows or changes the decompressed cel cache budget and statistics (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -461,6 +471,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" vm_profile - Profiles the executed SCI operations per method\n");
 	debugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	debugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	debugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -1129,6 +1140,50 @@ bool Console::cmdResourceTypes(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc == 3 && !scumm_stricmp(argv[1], "policy")) {
+		if (!scumm_stricmp(argv[2], "lru"))
+			resMan->setCachePolicy(kResCachePolicyLRU);
+		else if (!scumm_stricmp(argv[2], "slru"))
+			resMan->setCachePolicy(kResCachePolicySegmentedLRU);
+		else {
+			debugPrintf("Unknown policy '%s'\n", argv[2]);
+			return true;
+		}
+	} else if (argc == 3 && !scumm_stricmp(argv[1], "size")) {
+		const int size = atoi(argv[2]);
+		if (size <= 0) {
+			debugPrintf("Invalid size '%s'\n", argv[2]);
+			return true;
+		}
+		resMan->setCacheMemoryLimit(size * 1024);
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		resMan->resetCacheStats();
+	} else if (argc != 1) {
+		debugPrintf("Shows the state of the resource cache, or changes its settings\n");
+		debugPrintf("Usage: %s [policy lru|slru] [size <KiB>] [reset]\n", argv[0]);
+		debugPrintf("  policy - Selects plain or segmented LRU eviction\n");
+		debugPrintf("  size - Sets the memory budget for unlocked resources\n");
+		debugPrintf("  reset - Resets the statistics\n");
+		return true;
+	}
+
+	const ResourceCacheStats &stats = resMan->getCacheStats();
+	const uint32 requests = stats.hits + stats.misses;
+
+	debugPrintf("Policy: %s\n", resMan->getCachePolicy() == kResCachePolicySegmentedLRU ? "segmented LRU" : "LRU");
+	debugPrintf("Budget: %d KiB, cached: %d KiB (%d KiB protected), locked: %d KiB\n",
+	            resMan->getCacheMemoryLimit() / 1024, resMan->getCacheMemoryUsed() / 1024,
+	            resMan->getCacheMemoryProtected() / 1024, resMan->getLockedMemory() / 1024);
+	debugPrintf("Requests: %u, hits: %u, misses: %u, hit rate: %u%%\n",
+	            requests, stats.hits, stats.misses, requests ? stats.hits * 100 / requests : 0);
+	debugPrintf("Evictions: %u (%u KiB)\n", stats.evictions, stats.bytesEvicted / 1024);
+
+	return true;
+}
+
 bool Console::cmdHexgrep(int argc, const char **argv) {
 	if (argc < 4) {
 		debugPrintf("Searches some resources for a particular sequence of bytes, represented as decimal or hexadecimal numbers.\n");
@@ -2100,6 +2155,50 @@ bool Console::cmdPlaneList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	CelPixelCache *cache = CelObj::getPixelCache();
+	if (!_engine->_gfxFrameout) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	} else if (!cache) {
+		debugPrintf("The cel cache is disabled\n");
+		return true;
+	}
+
+	if (argc == 3 && !scumm_stricmp(argv[1], "size")) {
+		const int size = atoi(argv[2]);
+		if (size <= 0) {
+			debugPrintf("Invalid size '%s'\n", argv[2]);
+			return true;
+		}
+		cache->setBudget(size * 1024);
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		cache->resetStats();
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "clear")) {
+		cache->clear();
+	} else if (argc != 1) {
+		debugPrintf("Shows the state of the decompressed cel cache, or changes its settings\n");
+		debugPrintf("Usage: %s [size <KiB>] [reset] [clear]\n", argv[0]);
+		debugPrintf("  size - Sets the memory budget for decompressed cels\n");
+		debugPrintf("  reset - Resets the statistics\n");
+		debugPrintf("  clear - Frees all cached cels\n");
+		return true;
+	}
+
+	const CelPixelCache::Stats &stats = cache->getStats();
+	const uint32 requests = stats.hits + stats.misses;
+
+	debugPrintf("Budget: %d KiB, cached: %d KiB in %d cels\n", cache->getBudget() / 1024, cache->getMemoryUsed() / 1024, cache->getEntryCount());
+	debugPrintf("Requests: %u, hits: %u, misses: %u, hit rate: %u%%\n",
+	            requests, stats.hits, stats.misses, requests ? stats.hits * 100 / requests : 0);
+	debugPrintf("Evictions: %u\n", stats.evictions);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdVisiblePlaneList(int argc, const char **argv) {
 #ifdef ENABLE_SCI32
 	if (_engine->_gfxFrameout) {
@@ -3286,6 +3385,53 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+static bool compareMethodProfiles(const MethodProfile *a, const MethodProfile *b) {
+	return a->ops > b->ops;
+}
+
+bool Console::cmdVMProfile(int argc, const char **argv) {
+	if (argc == 2 && !scumm_stricmp(argv[1], "on")) {
+		_debugState.profiling = true;
+		_debugState._profileStack.clear();
+		_debugState._profileTimestamp = g_system->getMillis();
+		debugPrintf("Profiling enabled\n");
+		return true;
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "off")) {
+		_debugState.profiling = false;
+		_debugState._currentProfile = NULL;
+		_debugState._profileStack.clear();
+		debugPrintf("Profiling disabled\n");
+		return true;
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		_debugState._currentProfile = NULL;
+		_debugState._profileStack.clear();
+		_debugState._methodProfiles.clear();
+		return true;
+	} else if (argc > 2 || (argc == 2 && atoi(argv[1]) <= 0)) {
+		debugPrintf("Profiles the executed SCI operations per method\n");
+		debugPrintf("Usage: %s [on|off|reset|<count>]\n", argv[0]);
+		debugPrintf("Without parameters, shows the 20 methods which executed the most operations\n");
+		debugPrintf("Times include the kernel calls of a method, but not the methods it calls\n");
+		return true;
+	}
+
+	const uint count = (argc == 2) ? atoi(argv[1]) : 20;
+
+	Common::Array<const MethodProfile *> profiles;
+	for (MethodProfileMap::const_iterator it = _debugState._methodProfiles.begin(); it != _debugState._methodProfiles.end(); ++it)
+		profiles.push_back(&it->_value);
+	Common::sort(profiles.begin(), profiles.end(), compareMethodProfiles);
+
+	debugPrintf("Profiling is %s, %d methods recorded\n", _debugState.profiling ? "enabled" : "disabled", profiles.size());
+	debugPrintf("%10s %10s %8s  %s\n", "ops", "calls", "ms", "method");
+	for (uint i = 0; i < profiles.size() && i < count; ++i) {
+		const MethodProfile &profile = *profiles[i];
+		debugPrintf("%10u %10u %8u  %s\n", profile.ops, profile.calls, profile.elapsed, profile.name.c_str());
+	}
+
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	int curScriptNr = -1;
 
@@ -23,7 +23,10 @@
 #ifndef SCI_DEBUG_H
 #define SCI_DEBUG_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
+#include "common/str.h"
 #include "sci/engine/vm_types.h"	// for StackPtr
 
 namespace Sci {
@@ -72,6 +75,35 @@ enum DebugSeeking {
 	kDebugSeekStepOver = 5      // Step forward until we reach same stack-level again
 };
 
+/**
+ * Identifies a script method for profiling, by the script it is in and the
+ * offset of its first instruction.
+ */
+struct MethodProfileKey {
+	uint16 script;
+	uint32 offset;
+
+	bool operator==(const MethodProfileKey &other) const {
+		return script == other.script && offset == other.offset;
+	}
+};
+
+struct MethodProfileKeyHash {
+	uint operator()(const MethodProfileKey &key) const { return (key.script << 16) ^ key.offset; }
+};
+
+/** Execution statistics of a single script method, see the vm_profile command */
+struct MethodProfile {
+	MethodProfile() : calls(0), ops(0), elapsed(0) {}
+
+	Common::String name;
+	uint32 calls;   ///< Number of calls of the method
+	uint32 ops;     ///< Number of instructions executed in the method itself
+	uint32 elapsed; ///< Milliseconds spent in the method itself, including its kernel calls
+};
+
+typedef Common::HashMap<MethodProfileKey, MethodProfile, MethodProfileKeyHash> MethodProfileMap;
+
 struct DebugState {
 	bool debugging;
 	bool breakpointWasHit;
@@ -85,6 +117,12 @@ struct DebugState {
 	Common::List<Breakpoint> _breakpoints;   //< List of breakpoints
 	int _activeBreakpointTypes;  //< Bit mask specifying which types of breakpoints are active
 
+	bool profiling;                  //< Gather per method statistics in run_vm
+	MethodProfileMap _methodProfiles;
+	MethodProfile *_currentProfile;  //< Profile of the running method, or NULL if unknown
+	Common::Array<MethodProfile *> _profileStack; //< Profiles of the methods on the execution stack
+	uint32 _profileTimestamp;        //< Time of the last switch between methods
+
 	void updateActiveBreakpointTypes();
 };
 
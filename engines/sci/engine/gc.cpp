@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -191,6 +192,9 @@ void run_gc(EngineState *s) {
 	memset(segcount, 0, sizeof(segcount));
 #endif
 
+	const uint32 startTime = g_system->getMillis();
+	uint live = 0, freed = 0;
+
 	// Compute the set of all segments references currently in use.
 	AddrSet *activeRefs = findAllActiveReferences(s);
 
@@ -215,9 +219,12 @@ void run_gc(EngineState *s) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					freed++;
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
+				} else {
+					live++;
 				}
 			}
 
@@ -226,6 +233,11 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	segMan->notifyGCFinished(live);
+	s->gcSkipCount = 0;
+
+	debugC(kDebugLevelGC, "[GC] Freed %d entities, %d still in use, took %d ms", freed, live, g_system->getMillis() - startTime);
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -235,4 +247,17 @@ void run_gc(EngineState *s) {
 #endif
 }
 
+void run_gc_periodic(EngineState *s) {
+	const SegManager *segMan = s->_segMan;
+	const uint threshold = MAX<uint>(GC_MIN_ALLOCATIONS, segMan->getLiveAfterGC() / 2);
+
+	if (segMan->getAllocationsSinceGC() < threshold && s->gcSkipCount < GC_MAX_SKIPPED) {
+		debugC(kDebugLevelGC, "[GC] Skipped, only %d allocations since the last run", segMan->getAllocationsSinceGC());
+		s->gcSkipCount++;
+		return;
+	}
+
+	run_gc(s);
+}
+
 } // End of namespace Sci
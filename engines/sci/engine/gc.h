@@ -55,6 +55,17 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+/**
+ * Runs garbage collection on the current system state, unless it is not
+ * worth it yet. A full collection always has to trace every reachable
+ * object, so it is skipped while only few collectable entities have been
+ * allocated compared to the number of entities which survived the last
+ * collection. At most GC_MAX_SKIPPED collections are skipped in a row, so
+ * that unreachable entities are still freed eventually.
+ * @param s The state in which we should gc
+ */
+void run_gc_periodic(EngineState *s);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
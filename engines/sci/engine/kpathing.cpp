@@ -63,6 +63,21 @@ enum {
 
 #define VERTEX_HAS_EDGES(V) ((V) != CLIST_NEXT(V))
 
+// Size in pixels of the cells of the spatial index of polygon edges
+#define EDGE_GRID_CELL_SIZE 32
+
+// Number of polygon lists for which visibility information is kept, and the
+// maximum number of vertices of such a list
+#define AVOIDPATH_CACHE_SIZE 4
+#define AVOIDPATH_CACHE_MAX_VERTICES 512
+
+// Visibility matrix entries
+enum {
+	VIS_UNKNOWN = 0,
+	VIS_VISIBLE = 1,
+	VIS_BLOCKED = 2
+};
+
 // Error codes
 enum {
 	PF_OK = 0,
@@ -111,10 +126,14 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Index in the visibility matrix, -1 if the vertex is not part of it
+	int cacheIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		cacheIndex = -1;
 	}
 };
 
@@ -257,6 +276,21 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Visibility matrix of the vertices with a cacheIndex, shared with
+	// later calls for the same polygon list. NULL if it can't be used
+	byte *_visibility;
+	uint _visibilityStride;
+
+	// Spatial index of the polygon edges. Each grid cell lists the edges
+	// (as indices into vertex_index) whose bounding box overlaps the cell
+	int _gridColumns, _gridRows;
+	Common::Array<Common::Array<int> > _grid;
+
+	// Number of the last query that tested each edge, so that edges which
+	// overlap several cells are only tested once per query
+	Common::Array<uint32> _edgeQuery;
+	uint32 _queryCount;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -264,6 +298,10 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		_visibility = NULL;
+		_visibilityStride = 0;
+		_gridColumns = _gridRows = 0;
+		_queryCount = 0;
 	}
 
 	~PathfindingState() {
@@ -659,6 +697,99 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Returns the grid cell containing a coordinate. Coordinates outside of the
+ * screen are clipped to the border cells.
+ */
+static int grid_cell(int coord, int cells) {
+	return CLIP<int>(coord / EDGE_GRID_CELL_SIZE, 0, cells - 1);
+}
+
+/**
+ * Builds the spatial index of the polygon edges
+ * @param s				the pathfinding state
+ */
+static void build_edge_grid(PathfindingState *s) {
+	s->_gridColumns = MAX(1, (s->_width + EDGE_GRID_CELL_SIZE - 1) / EDGE_GRID_CELL_SIZE);
+	s->_gridRows = MAX(1, (s->_height + EDGE_GRID_CELL_SIZE - 1) / EDGE_GRID_CELL_SIZE);
+	s->_grid.resize(s->_gridColumns * s->_gridRows);
+	s->_edgeQuery.resize(s->vertices);
+
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (!VERTEX_HAS_EDGES(edge))
+			continue;
+
+		const Common::Point &p = edge->v;
+		const Common::Point &q = CLIST_NEXT(edge)->v;
+		const int x1 = grid_cell(MIN(p.x, q.x), s->_gridColumns);
+		const int x2 = grid_cell(MAX(p.x, q.x), s->_gridColumns);
+		const int y1 = grid_cell(MIN(p.y, q.y), s->_gridRows);
+		const int y2 = grid_cell(MAX(p.y, q.y), s->_gridRows);
+
+		for (int y = y1; y <= y2; y++)
+			for (int x = x1; x <= x2; x++)
+				s->_grid[y * s->_gridColumns + x].push_back(j);
+	}
+}
+
+/**
+ * Determines whether two vertices are visible from each other
+ * @param s				the pathfinding state
+ * @param vertex_cur	the first vertex
+ * @param vertex		the second vertex
+ * @return true if the line between the vertices doesn't intersect any polygon
+ */
+static bool visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges. An edge can only intersect the line
+	// if their bounding boxes overlap, so only the edges in the grid cells
+	// covered by the line need to be checked.
+	const Common::Point &a = vertex_cur->v;
+	const Common::Point &b = vertex->v;
+	const int x1 = grid_cell(MIN(a.x, b.x), s->_gridColumns);
+	const int x2 = grid_cell(MAX(a.x, b.x), s->_gridColumns);
+	const int y1 = grid_cell(MIN(a.y, b.y), s->_gridRows);
+	const int y2 = grid_cell(MAX(a.y, b.y), s->_gridRows);
+
+	if (++s->_queryCount == 0) {
+		for (uint j = 0; j < s->_edgeQuery.size(); j++)
+			s->_edgeQuery[j] = 0;
+		s->_queryCount = 1;
+	}
+
+	for (int y = y1; y <= y2; y++) {
+		for (int x = x1; x <= x2; x++) {
+			const Common::Array<int> &cell = s->_grid[y * s->_gridColumns + x];
+
+			for (uint i = 0; i < cell.size(); i++) {
+				const int j = cell[i];
+				if (s->_edgeQuery[j] == s->_queryCount)
+					continue;
+				s->_edgeQuery[j] = s->_queryCount;
+
+				Vertex *edge = s->vertex_index[j];
+				if (between(a, b, edge->v)) {
+					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+					if ((inside(a, edge)) || (inside(b, edge)))
+						return false;
+
+					// This edge won't properly intersect, so we continue
+					continue;
+				}
+
+				if (intersect_proper(a, b, edge->v, CLIST_NEXT(edge)->v))
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -667,34 +798,29 @@ static int inside(const Common::Point &p, Vertex *vertex) {
  */
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
+	const bool cached = s->_visibility && vertex_cur->cacheIndex >= 0;
 
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		if (vertex == vertex_cur)
 			continue;
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+		bool isVisible;
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
+		if (cached && vertex->cacheIndex >= 0) {
+			// Visibility is symmetric, so fill in both matrix entries
+			byte &entry = s->_visibility[vertex_cur->cacheIndex * s->_visibilityStride + vertex->cacheIndex];
+			if (entry == VIS_UNKNOWN) {
+				entry = visible(s, vertex_cur, vertex) ? VIS_VISIBLE : VIS_BLOCKED;
+				s->_visibility[vertex->cacheIndex * s->_visibilityStride + vertex_cur->cacheIndex] = entry;
 			}
+			isVisible = (entry == VIS_VISIBLE);
+		} else {
+			isVisible = visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (isVisible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1185,6 +1311,64 @@ static void change_polygons_opt_0(PathfindingState *s) {
 	}
 }
 
+/**
+ * Looks up the visibility matrix for a polygon set, creating or resetting it
+ * if the polygons changed since the last call for the same polygon list
+ * Parameters: (EngineState *) s: The game state
+ *             (reg_t) poly_list: Polygon list
+ *             (PathfindingState *) pf_s: The freshly converted polygon set
+ *             (int &) count: Set to the number of vertices in the matrix
+ * Returns   : (AvoidPathCacheEntry *) The cache entry, or NULL if the
+ *             polygon set is too large to be cached
+ */
+static AvoidPathCacheEntry *lookup_visibility_cache(EngineState *s, reg_t poly_list, PathfindingState *pf_s, int &count) {
+	Common::Array<int16> polygons;
+	count = 0;
+
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		polygons.push_back((*it)->vertices.size());
+
+		Vertex *vertex;
+		CLIST_FOREACH(vertex, &(*it)->vertices) {
+			polygons.push_back(vertex->v.x);
+			polygons.push_back(vertex->v.y);
+			vertex->cacheIndex = count++;
+		}
+	}
+
+	if (count == 0 || count > AVOIDPATH_CACHE_MAX_VERTICES)
+		return NULL;
+
+	Common::List<AvoidPathCacheEntry> &cache = s->_avoidPathCache;
+	Common::List<AvoidPathCacheEntry>::iterator it;
+
+	for (it = cache.begin(); it != cache.end(); ++it) {
+		if (it->polyList == poly_list)
+			break;
+	}
+
+	if (it == cache.end()) {
+		if (cache.size() >= AVOIDPATH_CACHE_SIZE)
+			cache.pop_back();
+		cache.push_front(AvoidPathCacheEntry());
+		cache.front().polyList = poly_list;
+	} else if (it != cache.begin()) {
+		cache.push_front(*it);
+		cache.erase(it);
+	}
+
+	AvoidPathCacheEntry &entry = cache.front();
+
+	if (entry.polygons != polygons) {
+		debugC(kDebugLevelAvoidPath, "AvoidPath: Polygon list %04x:%04x changed, resetting visibility cache", PRINT_REG(poly_list));
+		entry.polygons = polygons;
+		entry.visibility.clear();
+		entry.visibility.resize(count * count);
+	}
+
+	return &entry;
+}
+
 /**
  * Converts the SCI input data for pathfinding
  * Parameters: (EngineState *) s: The game state
@@ -1220,6 +1404,9 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	int cachedVertices;
+	AvoidPathCacheEntry *cacheEntry = lookup_visibility_cache(s, poly_list, pf_s, cachedVertices);
+
 	if (opt == 0)
 		change_polygons_opt_0(pf_s);
 
@@ -1288,17 +1475,35 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 
 	count = 0;
 
+	// The visibility matrix is only valid as long as the edges are those of
+	// the polygon list, i.e. no polygons were removed above and the start
+	// and end points did not split up an edge
+	int unchangedVertices = 0;
+	bool edgesChanged = false;
+
 	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
 		polygon = *it;
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
 			pf_s->vertex_index[count++] = vertex;
+
+			if (vertex->cacheIndex >= 0)
+				unchangedVertices++;
+			else if (VERTEX_HAS_EDGES(vertex))
+				edgesChanged = true;
 		}
 	}
 
 	pf_s->vertices = count;
 
+	if (cacheEntry && unchangedVertices == cachedVertices && !edgesChanged) {
+		pf_s->_visibility = cacheEntry->visibility.begin();
+		pf_s->_visibilityStride = cachedVertices;
+	}
+
+	build_edge_grid(pf_s);
+
 	return pf_s;
 }
 
@@ -70,6 +70,8 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_objects.clear();
 
 	_offsetLookupArray.clear();
+	_decodedInstructions.clear();
+	_instructionsDecoded = 0;
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
@@ -1286,4 +1288,29 @@ bool Script::offsetIsObject(uint32 offset) const {
 	return _buf->getUint16SEAt(offset + SCRIPT_OBJECT_MAGIC_OFFSET) == SCRIPT_OBJECT_MAGIC_NUMBER;
 }
 
+int Script::decodeInstructionUncached(uint32 offset, byte &extOpcode, int16 opparams[4]) {
+	const int size = readPMachineInstruction(getBuf(offset), extOpcode, opparams);
+
+	// Script patches are applied when the script is loaded, so the cache
+	// always holds the patched code. Scripts never modify their own code.
+	if (_decodedInstructions.empty()) {
+		if (++_instructionsDecoded < kDecodeCacheThreshold)
+			return size;
+		_decodedInstructions.resize(getBufSize());
+	}
+
+	// Instructions with longer operands (only the file name of the debug
+	// opcode op_file) are simply decoded every time
+	if (size <= 0xFF) {
+		DecodedInstruction &instruction = _decodedInstructions[offset];
+		instruction.opparams[0] = opparams[0];
+		instruction.opparams[1] = opparams[1];
+		instruction.opparams[2] = opparams[2];
+		instruction.extOpcode = extOpcode;
+		instruction.size = size;
+	}
+
+	return size;
+}
+
 } // End of namespace Sci
@@ -102,6 +102,30 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * An instruction as returned by readPMachineInstruction(). The fourth
+	 * parameter is always zero and not stored.
+	 */
+	struct DecodedInstruction {
+		int16 opparams[3];
+		byte extOpcode;
+		byte size; /**< Size of the instruction in bytes, or 0 if not decoded yet */
+	};
+
+	/**
+	 * Decoded instructions, indexed by their offset in the script buffer.
+	 * Only allocated for scripts which execute a lot of instructions, once
+	 * _instructionsDecoded reaches kDecodeCacheThreshold.
+	 */
+	Common::Array<DecodedInstruction> _decodedInstructions;
+	uint32 _instructionsDecoded;
+
+	enum {
+		kDecodeCacheThreshold = 20000
+	};
+
+	int decodeInstructionUncached(uint32 offset, byte &extOpcode, int16 opparams[4]);
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -128,6 +152,29 @@ public:
 	const ObjMap &getObjectMap() const { return _objects; }
 	bool offsetIsObject(uint32 offset) const;
 
+	/**
+	 * Reads the instruction at the given offset of the script buffer, like
+	 * readPMachineInstruction(). Frequently executed scripts keep their
+	 * decoded instructions, so that loops do not decode the same
+	 * instructions over and over again.
+	 * @return the size of the instruction in bytes
+	 */
+	int decodeInstruction(uint32 offset, byte &extOpcode, int16 opparams[4]) {
+		if (!_decodedInstructions.empty()) {
+			const DecodedInstruction &instruction = _decodedInstructions[offset];
+			if (instruction.size) {
+				extOpcode = instruction.extOpcode;
+				opparams[0] = instruction.opparams[0];
+				opparams[1] = instruction.opparams[1];
+				opparams[2] = instruction.opparams[2];
+				opparams[3] = 0;
+				return instruction.size;
+			}
+		}
+
+		return decodeInstructionUncached(offset, extOpcode, opparams);
+	}
+
 public:
 	Script();
 	~Script();
@@ -31,6 +31,7 @@
 #include "sci/engine/scriptdebug.h"
 
 #include "common/algorithm.h"
+#include "common/system.h"
 
 namespace Sci {
 
@@ -1065,6 +1066,54 @@ void logKernelCall(const KernelFunction *kernelCall, const KernelSubFunction *ke
 }
 
 
+static Common::String describeMethod(EngineState *s, const ExecStack &call, const Script *scr) {
+	if (call.debugSelector != -1)
+		return Common::String::format("%s::%s", s->_segMan->getObjectName(call.sendp), g_sci->getKernel()->getSelectorName(call.debugSelector).c_str());
+	else if (call.debugExportId != -1)
+		return Common::String::format("script %d export %d", scr->getScriptNumber(), call.debugExportId);
+	else
+		return Common::String::format("script %d call %x", scr->getScriptNumber(), call.addr.pc.getOffset());
+}
+
+void profileStackFrameChange(EngineState *s, const Script *scr) {
+	DebugState &debugState = g_sci->_debugState;
+
+	// Attribute the time since the last switch to the method which ran
+	// until now. With millisecond resolution most switches add nothing,
+	// and every tick is charged to whichever method runs when it happens,
+	// which averages out over many calls.
+	const uint32 now = g_system->getMillis();
+	if (debugState._currentProfile)
+		debugState._currentProfile->elapsed += now - debugState._profileTimestamp;
+	debugState._profileTimestamp = now;
+
+	const uint depth = s->_executionStack.size();
+	debugState._profileStack.resize(depth);
+	debugState._currentProfile = NULL;
+
+	if (!depth || s->_executionStack.back().type != EXEC_STACK_TYPE_CALL)
+		return;
+
+	const ExecStack &call = s->_executionStack.back();
+
+	MethodProfile *&profile = debugState._profileStack.back();
+	if (!profile) {
+		// Entering a new frame, so the program counter is still at the
+		// beginning of the method. Frames which were already running when
+		// profiling was enabled end up with an entry of their own.
+		MethodProfileKey key;
+		key.script = scr->getScriptNumber();
+		key.offset = call.addr.pc.getOffset();
+
+		profile = &debugState._methodProfiles[key];
+		if (profile->name.empty())
+			profile->name = describeMethod(s, call, scr);
+		profile->calls++;
+	}
+
+	debugState._currentProfile = profile;
+}
+
 void logBacktrace() {
 	Console *con = g_sci->getSciDebugger();
 	EngineState *s = g_sci->getEngineState();
@@ -37,6 +37,13 @@ void logKernelCall(const KernelFunction *kernelCall, const KernelSubFunction *ke
 
 void logBacktrace();
 
+/**
+ * Updates the method profiles when run_vm switches to another stack frame.
+ * Only called while profiling is enabled.
+ * @param scr	the script containing the code of the new frame
+ */
+void profileStackFrameChange(EngineState *s, const Script *scr);
+
 bool printObject(reg_t obj);
 
 bool matchKernelBreakpointPattern(const Common::String &pattern, const Common::String &name);
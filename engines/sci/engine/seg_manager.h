@@ -456,6 +456,28 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * Returns the number of garbage collectable entities which were allocated
+	 * (or, in the case of scripts, marked as deleted) since the last garbage
+	 * collection. Garbage can only accumulate through these.
+	 */
+	uint getAllocationsSinceGC() const { return _allocationsSinceGC; }
+
+	/**
+	 * Returns the number of garbage collectable entities which survived the
+	 * last garbage collection.
+	 */
+	uint getLiveAfterGC() const { return _liveAfterGC; }
+
+	/**
+	 * Called by the garbage collector once it has finished.
+	 * @param live	number of collectable entities still in use
+	 */
+	void notifyGCFinished(uint live) {
+		_allocationsSinceGC = 0;
+		_liveAfterGC = live;
+	}
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -470,6 +492,9 @@ private:
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
 	SegmentId _hunksSegId; ///< ID of the (a) hunk segment
 
+	uint _allocationsSinceGC; ///< Collectable entities allocated since the last garbage collection
+	uint _liveAfterGC; ///< Collectable entities which survived the last garbage collection
+
 	// Statically allocated memory for system strings
 	reg_t _saveDirPtr;
 	reg_t _parserPtr;
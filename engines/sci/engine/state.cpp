@@ -100,6 +100,7 @@ void EngineState::reset(bool isRestoring) {
 	lastWaitTime = 0;
 
 	gcCountDown = 0;
+	gcSkipCount = 0;
 
 #ifdef ENABLE_SCI32
 	_eventCounter = 0;
@@ -119,6 +120,8 @@ void EngineState::reset(bool isRestoring) {
 	scriptGCInterval = GC_INTERVAL;
 
 	_videoState.reset();
+
+	_avoidPathCache.clear();
 }
 
 void EngineState::speedThrottler(uint32 neededSleep) {
@@ -25,6 +25,7 @@
 
 #include "common/scummsys.h"
 #include "common/array.h"
+#include "common/list.h"
 #include "common/serializer.h"
 #include "common/str-array.h"
 
@@ -95,6 +96,16 @@ struct VideoState {
 	}
 };
 
+/**
+ * Visibility information kept by kAvoidPath between calls for the same
+ * polygon list, see kpathing.cpp.
+ */
+struct AvoidPathCacheEntry {
+	reg_t polyList; ///< The polygon list the entry was computed for
+	Common::Array<int16> polygons; ///< Vertex counts and points of the converted polygons, used to detect changes
+	Common::Array<byte> visibility; ///< Lazily filled visibility matrix between all vertices of the polygons
+};
+
 /**
  * Trace information about a VM function call.
  */
@@ -201,6 +212,7 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	uint gcSkipCount; /**< Number of periodic gcs skipped in a row */
 
 	MessageState *_msgState;
 
@@ -212,6 +224,8 @@ public:
 	uint16 _memorySegmentSize;
 	byte _memorySegment[kMemorySegmentMax];
 
+	Common::List<AvoidPathCacheEntry> _avoidPathCache; ///< Most recently used first
+
 	// TODO: Excise video code from the state manager
 	VideoState _videoState;
 
@@ -624,6 +624,9 @@ void run_vm(EngineState *s) {
 			}
 			s->variables[VAR_TEMP] = s->xs->fp;
 			s->variables[VAR_PARAM] = s->xs->variables_argp;
+
+			if (g_sci->_debugState.profiling)
+				profileStackFrameChange(s, scr);
 		}
 
 		if (s->abortScriptProcessing != kAbortNone)
@@ -652,8 +655,11 @@ void run_vm(EngineState *s) {
 
 		// Get opcode
 		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		s->xs->addr.pc.incOffset(scr->decodeInstruction(s->xs->addr.pc.getOffset(), extOpcode, opparams));
 		const byte opcode = extOpcode >> 1;
+
+		if (g_sci->_debugState._currentProfile)
+			g_sci->_debugState._currentProfile->ops++;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
 #ifdef ABORT_ON_INFINITE_LOOP
@@ -878,7 +884,7 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_gc_periodic(s);
 			}
 
 			// Call kernel function
@@ -184,6 +184,15 @@ enum {
 	GC_INTERVAL = 0x8000
 };
 
+/**
+ * Limits for skipping periodic gcs when little has been allocated since the
+ * last one, see run_gc_periodic()
+ */
+enum {
+	GC_MIN_ALLOCATIONS = 256,
+	GC_MAX_SKIPPED = 4
+};
+
 enum SciOpcodes {
 	op_bnot     = 0x00,	// 000
 	op_add      = 0x01,	// 001
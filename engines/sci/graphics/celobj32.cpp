@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/config-manager.h"
 #include "sci/resource.h"
 #include "sci/engine/features.h"
 #include "sci/engine/seg_manager.h"
@@ -32,6 +33,17 @@
 #include "sci/engine/workarounds.h"
 #include "sci/util.h"
 
+// Use the vector unit for drawing unscaled rows where the compiler guarantees
+// it is present (SSE2 is part of the x86-64 baseline, NEON of AArch64 and of
+// ARM builds using -mfpu=neon).
+#if defined(__SSE2__)
+#define CELOBJ_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CELOBJ_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Sci {
 #pragma mark CelScaler
 
@@ -89,11 +101,20 @@ void CelObj::init() {
 	_nextCacheId = 1;
 	_scaler.reset(new CelScaler());
 	_cache.reset(new CelCache(100));
+
+	int pixelCacheSize = 4096;
+	if (ConfMan.hasKey("cel_cache_size")) {
+		pixelCacheSize = ConfMan.getInt("cel_cache_size");
+	}
+	if (pixelCacheSize > 0) {
+		_pixelCache.reset(new CelPixelCache(pixelCacheSize * 1024));
+	}
 }
 
 void CelObj::deinit() {
 	_scaler.reset();
 	_cache.reset();
+	_pixelCache.reset();
 }
 
 #pragma mark -
@@ -144,6 +165,13 @@ struct SCALER_NoScale {
 			return *_row++;
 		}
 	}
+
+	inline const byte *readRow(const int16 width) {
+		assert(!FLIP && _row + width <= _rowEdge);
+		const byte *row = _row;
+		_row += width;
+		return row;
+	}
 };
 
 template<bool FLIP, typename READER>
@@ -294,26 +322,39 @@ private:
 	uint32 _uncompressedDataOffset;
 	int16 _y;
 	const int16 _sourceHeight;
+	const int16 _sourceWidth;
 	const uint8 _skipColor;
 	const int16 _maxWidth;
+	const byte *_cachedPixels;
 
 public:
-	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
+	READER_Compressed(const CelObj &celObj, const int16 maxWidth, const bool useCache = true) :
 	_resource(celObj.getResPointer()),
 	_y(-1),
 	_sourceHeight(celObj._height),
+	_sourceWidth(celObj._width),
 	_skipColor(celObj._skipColor),
-	_maxWidth(maxWidth) {
+	_maxWidth(maxWidth),
+	_cachedPixels(nullptr) {
 		assert(maxWidth <= celObj._width);
 
 		const SciSpan<const byte> celHeader = _resource.subspan(celObj._celHeaderOffset);
 		_dataOffset = celHeader.getUint32SEAt(24);
 		_uncompressedDataOffset = celHeader.getUint32SEAt(28);
 		_controlOffset = celHeader.getUint32SEAt(32);
+
+		CelPixelCache *pixelCache = CelObj::getPixelCache();
+		if (useCache && pixelCache) {
+			_cachedPixels = pixelCache->getPixels(celObj);
+		}
 	}
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
+		if (_cachedPixels) {
+			return _cachedPixels + y * _sourceWidth;
+		}
+
 		if (y != _y) {
 			// compressed data segment for row
 			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
@@ -371,9 +412,140 @@ public:
 	}
 };
 
+#pragma mark -
+#pragma mark CelObj - Pixel cache
+
+Common::ScopedPtr<CelPixelCache> CelObj::_pixelCache;
+
+const byte *CelPixelCache::getPixels(const CelObj &celObj) {
+	if (celObj._compressionType != kCelCompressionRLE ||
+		(celObj._info.type != kCelTypeView && celObj._info.type != kCelTypePic)) {
+		return nullptr;
+	}
+
+	Key key;
+	key.type = celObj._info.type;
+	key.resourceId = celObj._info.resourceId;
+	key.loopNo = celObj._info.loopNo;
+	key.celNo = celObj._info.celNo;
+
+	EntryMap::iterator it = _map.find(key);
+	if (it != _map.end()) {
+		++_stats.hits;
+		EntryList::iterator entry = it->_value;
+		if (entry != _entries.begin()) {
+			_entries.push_front(*entry);
+			_entries.erase(entry);
+			it->_value = _entries.begin();
+		}
+		return _entries.front().pixels;
+	}
+
+	++_stats.misses;
+
+	const uint32 size = celObj._width * celObj._height;
+	if (size == 0 || size > _budget / 4) {
+		return nullptr;
+	}
+
+	makeRoom(size);
+
+	Entry entry;
+	entry.key = key;
+	entry.size = size;
+	entry.pixels = (byte *)malloc(size);
+	if (!entry.pixels) {
+		return nullptr;
+	}
+
+	READER_Compressed reader(celObj, celObj._width, false);
+	for (int16 y = 0; y < celObj._height; ++y) {
+		memcpy(entry.pixels + y * celObj._width, reader.getRow(y), celObj._width);
+	}
+
+	_entries.push_front(entry);
+	_map.setVal(key, _entries.begin());
+	_memoryUsed += size;
+	return entry.pixels;
+}
+
+void CelPixelCache::makeRoom(const uint32 size) {
+	while (!_entries.empty() && _memoryUsed + size > _budget) {
+		Entry &entry = _entries.back();
+		_map.erase(entry.key);
+		_memoryUsed -= entry.size;
+		free(entry.pixels);
+		_entries.pop_back();
+		++_stats.evictions;
+	}
+}
+
+void CelPixelCache::clear() {
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		free(it->pixels);
+	}
+	_entries.clear();
+	_map.clear();
+	_memoryUsed = 0;
+}
+
+void CelPixelCache::setBudget(const uint32 budget) {
+	_budget = budget;
+	makeRoom(0);
+}
+
 #pragma mark -
 #pragma mark CelObj - Remappers
 
+/**
+ * Copies a row of pixels, except for those which have the skip color or, if
+ * LIMIT is set, are not below `endColor`.
+ */
+template<bool LIMIT>
+static inline void drawRowSkip(byte *target, const byte *source, const int16 width, const uint8 skipColor, const int endColor) {
+	if (LIMIT && endColor <= 0) {
+		return;
+	}
+
+	int16 x = 0;
+
+#if defined(CELOBJ_USE_SSE2)
+	const __m128i skip = _mm_set1_epi8((char)skipColor);
+	const __m128i last = _mm_set1_epi8((char)(endColor - 1));
+	const __m128i ones = _mm_set1_epi8((char)0xFF);
+	for (; x + 16 <= width; x += 16) {
+		const __m128i src = _mm_loadu_si128((const __m128i *)(source + x));
+		const __m128i dst = _mm_loadu_si128((const __m128i *)(target + x));
+		__m128i keep = _mm_cmpeq_epi8(src, skip);
+		if (LIMIT) {
+			// There is no unsigned byte comparison in SSE2, but src <= last
+			// exactly when min(src, last) == src
+			keep = _mm_or_si128(keep, _mm_xor_si128(_mm_cmpeq_epi8(_mm_min_epu8(src, last), src), ones));
+		}
+		_mm_storeu_si128((__m128i *)(target + x), _mm_or_si128(_mm_andnot_si128(keep, src), _mm_and_si128(keep, dst)));
+	}
+#elif defined(CELOBJ_USE_NEON)
+	const uint8x16_t skip = vdupq_n_u8(skipColor);
+	const uint8x16_t end = vdupq_n_u8((uint8)endColor);
+	for (; x + 16 <= width; x += 16) {
+		const uint8x16_t src = vld1q_u8(source + x);
+		const uint8x16_t dst = vld1q_u8(target + x);
+		uint8x16_t draw = vmvnq_u8(vceqq_u8(src, skip));
+		if (LIMIT) {
+			draw = vandq_u8(draw, vcltq_u8(src, end));
+		}
+		vst1q_u8(target + x, vbslq_u8(draw, src, dst));
+	}
+#endif
+
+	for (; x < width; ++x) {
+		const byte pixel = source[x];
+		if (pixel != skipColor && (!LIMIT || pixel < endColor)) {
+			target[x] = pixel;
+		}
+	}
+}
+
 /**
  * Pixel mapper for a CelObj with transparent pixels and no
  * remapping data.
@@ -384,6 +556,10 @@ struct MAPPER_NoMD {
 			*target = pixel;
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		drawRowSkip<false>(target, source, width, skipColor, 0);
+	}
 };
 
 /**
@@ -394,6 +570,10 @@ struct MAPPER_NoMDNoSkip {
 	inline void draw(byte *target, const byte pixel, const uint8) const {
 		*target = pixel;
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8) const {
+		memcpy(target, source, width);
+	}
 };
 
 /**
@@ -412,6 +592,12 @@ struct MAPPER_Map {
 			}
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		for (int16 x = 0; x < width; ++x) {
+			draw(target++, *source++, skipColor);
+		}
+	}
 };
 
 /**
@@ -426,6 +612,10 @@ struct MAPPER_NoMap {
 			*target = pixel;
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		drawRowSkip<true>(target, source, width, skipColor, g_sci->_gfxRemap32->getStartColor());
+	}
 };
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
@@ -681,6 +871,38 @@ struct RENDERER {
 	}
 };
 
+/**
+ * Renderer for unscaled and unmirrored cels. Their source rows are contiguous,
+ * so whole rows are handed to the mapper at once.
+ */
+template<typename MAPPER, typename READER>
+struct RENDERER<MAPPER, SCALER_NoScale<false, READER>, false> {
+	MAPPER &_mapper;
+	SCALER_NoScale<false, READER> &_scaler;
+	const uint8 _skipColor;
+
+	RENDERER(MAPPER &mapper, SCALER_NoScale<false, READER> &scaler, const uint8 skipColor) :
+	_mapper(mapper),
+	_scaler(scaler),
+	_skipColor(skipColor) {}
+
+	inline void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
+		byte *targetPixel = (byte *)target.getPixels() + target.w * targetRect.top + targetRect.left;
+
+		const int16 targetWidth = targetRect.width();
+		const int16 targetHeight = targetRect.height();
+		if (targetWidth <= 0) {
+			return;
+		}
+
+		for (int16 y = 0; y < targetHeight; ++y) {
+			_scaler.setTarget(targetRect.left, targetRect.top + y);
+			_mapper.drawRow(targetPixel, _scaler.readRow(targetWidth), targetWidth, _skipColor);
+			targetPixel += target.w;
+		}
+	}
+};
+
 template<typename MAPPER, typename SCALER>
 void CelObj::render(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
 
@@ -23,6 +23,8 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource.h"
@@ -148,6 +150,100 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+/**
+ * A cache of the decompressed pixels of RLE compressed view and pic cels.
+ * Animated cels are usually drawn again every few frames, and this way they
+ * only need to be decompressed once. The least recently used cels are evicted
+ * when the decompressed pixels exceed the memory budget.
+ *
+ * Remapping is applied when a cel is drawn, so the decompressed pixels are
+ * the same regardless of the remap state.
+ */
+class CelPixelCache {
+public:
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+
+		Stats() : hits(0), misses(0), evictions(0) {}
+	};
+
+	CelPixelCache(const uint32 budget) : _budget(budget), _memoryUsed(0) {}
+	~CelPixelCache() { clear(); }
+
+	/**
+	 * Returns the decompressed pixels of the given cel, decompressing and
+	 * caching them if necessary. Returns null if the cel is not RLE
+	 * compressed or is too large for the cache. The pixels remain valid
+	 * until the next call.
+	 */
+	const byte *getPixels(const CelObj &celObj);
+
+	/**
+	 * Frees all cached pixels.
+	 */
+	void clear();
+
+	/**
+	 * Sets the maximum amount of memory to use for cached pixels, in bytes.
+	 */
+	void setBudget(const uint32 budget);
+
+	uint32 getBudget() const { return _budget; }
+	uint32 getMemoryUsed() const { return _memoryUsed; }
+	uint getEntryCount() const { return _entries.size(); }
+	const Stats &getStats() const { return _stats; }
+	void resetStats() { _stats = Stats(); }
+
+private:
+	struct Key {
+		CelType type;
+		GuiResourceId resourceId;
+		int16 loopNo;
+		int16 celNo;
+
+		inline bool operator==(const Key &other) const {
+			return type == other.type && resourceId == other.resourceId && loopNo == other.loopNo && celNo == other.celNo;
+		}
+	};
+
+	struct KeyHash {
+		inline uint operator()(const Key &key) const {
+			return (key.resourceId << 12) ^ (key.loopNo << 6) ^ key.celNo ^ (key.type << 28);
+		}
+	};
+
+	struct Entry {
+		Key key;
+		byte *pixels;
+		uint32 size;
+	};
+
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, KeyHash> EntryMap;
+
+	/**
+	 * Cached cels, most recently used first.
+	 */
+	EntryList _entries;
+
+	/**
+	 * Lookup table from cel to its position in `_entries`.
+	 */
+	EntryMap _map;
+
+	uint32 _budget;
+	uint32 _memoryUsed;
+	Stats _stats;
+
+	/**
+	 * Evicts the least recently used cels until `size` more bytes fit into
+	 * the budget.
+	 */
+	void makeRoom(const uint32 size);
+};
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -342,6 +438,12 @@ public:
 	 */
 	static void deinit();
 
+	/**
+	 * Returns the cache of decompressed cel pixels, or null if it is
+	 * disabled.
+	 */
+	static CelPixelCache *getPixelCache() { return _pixelCache.get(); }
+
 	virtual ~CelObj() {};
 
 	/**
@@ -456,6 +558,12 @@ protected:
 	 */
 	static Common::ScopedPtr<CelCache> _cache;
 
+	/**
+	 * A cache of decompressed cel pixels. Null if disabled with the
+	 * `cel_cache_size` setting.
+	 */
+	static Common::ScopedPtr<CelPixelCache> _pixelCache;
+
 	/**
 	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
 	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
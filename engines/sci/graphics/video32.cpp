@@ -126,6 +126,9 @@ VideoPlayer::EventFlags VideoPlayer::playUntilEvent(const EventFlags flags, cons
 
 	EventFlags stopFlag = kEventFlagNone;
 	for (;;) {
+		// Decode the next frame while waiting for it, so that expensive
+		// frames do not get displayed late
+		_decoder->decodeAhead();
 		g_sci->sleep(MIN(_decoder->getTimeToNextFrame(), maxSleepMs));
 
 		const Graphics::Surface *nextFrame = nullptr;
@@ -22,6 +22,7 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
@@ -208,6 +209,8 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
+	_protected = false;
+	_referenced = false;
 }
 
 Resource::~Resource() {
@@ -221,6 +224,7 @@ void Resource::unalloc() {
 	delete[] _data;
 	_data = nullptr;
 	_status = kResStatusNoMalloc;
+	_referenced = false;
 }
 
 void Resource::writeToStream(Common::WriteStream *stream) const {
@@ -966,7 +970,11 @@ void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
+	_memoryProtected = 0;
 	_LRU.clear();
+	_protectedLRU.clear();
+	_cachePolicy = kResCachePolicyLRU;
+	_cacheStats = ResourceCacheStats();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1021,6 +1029,24 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// Allow advanced users to trade memory for fewer reloads (or the other
+	// way around) by setting these in their ScummVM config file directly
+	if (!_detectionMode) {
+		if (ConfMan.hasKey("resource_cache_size")) {
+			const int size = ConfMan.getInt("resource_cache_size");
+			if (size > 0)
+				_maxMemoryLRU = size * 1024;
+		}
+
+		if (ConfMan.hasKey("resource_cache_policy")) {
+			const Common::String policy = ConfMan.get("resource_cache_policy");
+			if (policy.equalsIgnoreCase("slru"))
+				_cachePolicy = kResCachePolicySegmentedLRU;
+			else if (!policy.equalsIgnoreCase("lru"))
+				warning("resMan: Unknown resource cache policy '%s'", policy.c_str());
+		}
+	}
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1067,7 +1093,13 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+	if (res->_protected) {
+		_protectedLRU.erase(res->_lruPosition);
+		_memoryProtected -= res->size();
+		res->_protected = false;
+	} else {
+		_LRU.erase(res->_lruPosition);
+	}
 	_memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
 }
@@ -1077,7 +1109,15 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
+	if (_cachePolicy == kResCachePolicySegmentedLRU && res->_referenced) {
+		_protectedLRU.push_front(res);
+		res->_lruPosition = _protectedLRU.begin();
+		res->_protected = true;
+		_memoryProtected += res->size();
+	} else {
+		_LRU.push_front(res);
+		res->_lruPosition = _LRU.begin();
+	}
 	_memoryLRU += res->size();
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
@@ -1090,9 +1130,18 @@ void ResourceManager::addToLRU(Resource *res) {
 void ResourceManager::printLRU() {
 	int mem = 0;
 	int entries = 0;
-	Common::List<Resource *>::iterator it = _LRU.begin();
+	Common::List<Resource *>::iterator it = _protectedLRU.begin();
 	Resource *res;
 
+	while (it != _protectedLRU.end()) {
+		res = *it;
+		debug("\t%s: %u bytes (protected)", res->_id.toString().c_str(), res->size());
+		mem += res->size();
+		++entries;
+		++it;
+	}
+
+	it = _LRU.begin();
 	while (it != _LRU.end()) {
 		res = *it;
 		debug("\t%s: %u bytes", res->_id.toString().c_str(), res->size());
@@ -1105,17 +1154,50 @@ void ResourceManager::printLRU() {
 }
 
 void ResourceManager::freeOldResources() {
+	// The protected segment may use at most 3/4 of the budget. Its least
+	// recently used resources are moved back to the probation segment, where
+	// they get another chance to be requested before they are freed.
+	const int maxMemoryProtected = _maxMemoryLRU / 4 * 3;
+	while (maxMemoryProtected < _memoryProtected) {
+		Resource *demoted = _protectedLRU.back();
+		removeFromLRU(demoted);
+		demoted->_referenced = false;
+		addToLRU(demoted);
+	}
+
 	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+		assert(!_LRU.empty() || !_protectedLRU.empty());
+		Resource *goner = _LRU.empty() ? _protectedLRU.back() : _LRU.back();
 		removeFromLRU(goner);
-		goner->unalloc();
+		++_cacheStats.evictions;
+		_cacheStats.bytesEvicted += goner->size();
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
+		goner->unalloc();
+	}
+}
+
+void ResourceManager::setCachePolicy(ResourceCachePolicy policy) {
+	if (_cachePolicy == policy)
+		return;
+
+	_cachePolicy = policy;
+
+	// Move everything from the protected segment back to the plain list,
+	// keeping the protected resources at the recently used end
+	while (!_protectedLRU.empty()) {
+		Resource *res = _protectedLRU.back();
+		removeFromLRU(res);
+		addToLRU(res);
 	}
 }
 
+void ResourceManager::setCacheMemoryLimit(int bytes) {
+	_maxMemoryLRU = bytes;
+	freeOldResources();
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1135,15 +1217,21 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		++_cacheStats.misses;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
-		// The resource is removed from its current position
-		// in the LRU list because it has been requested
-		// again. Below, it will either be locked, or it
-		// will be added back to the LRU list at the 'most
-		// recent' position.
-		removeFromLRU(retval);
+	} else {
+		++_cacheStats.hits;
+		retval->_referenced = true;
+
+		if (retval->_status == kResStatusEnqueued)
+			// The resource is removed from its current position
+			// in the LRU list because it has been requested
+			// again. Below, it will either be locked, or it
+			// will be added back to the LRU list at the 'most
+			// recent' position.
+			removeFromLRU(retval);
+	}
 
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
@@ -62,6 +62,29 @@ enum ResourceStatus {
 	kResStatusLocked /**< Allocated and in use */
 };
 
+/** Strategies for choosing which unlocked resources to free */
+enum ResourceCachePolicy {
+	/** Free the least recently used resource first */
+	kResCachePolicyLRU = 0,
+	/**
+	 * Segmented LRU: resources which were requested again while still in
+	 * memory move to a protected segment, and resources which were only used
+	 * once are freed first. This keeps one-off loads (e.g. the pictures and
+	 * audio of a room transition) from pushing out frequently used resources.
+	 */
+	kResCachePolicySegmentedLRU
+};
+
+/** Counters describing how well the resource cache performs */
+struct ResourceCacheStats {
+	ResourceCacheStats() : hits(0), misses(0), evictions(0), bytesEvicted(0) {}
+
+	uint32 hits;         ///< Requests for resources which were already in memory
+	uint32 misses;       ///< Requests which had to load the resource
+	uint32 evictions;    ///< Resources freed to stay within the memory budget
+	uint32 bytesEvicted; ///< Total size of the freed resources
+};
+
 /** Resource error codes. Should be in sync with s_errorDescriptions */
 enum ResourceErrorCodes {
 	SCI_ERROR_NONE = 0,
@@ -299,6 +322,10 @@ protected:
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
+	Common::List<Resource *>::iterator _lruPosition; /**< Position in the LRU list, while enqueued */
+	bool _protected; /**< In the protected segment of the LRU, while enqueued */
+	bool _referenced; /**< Requested again since it was loaded */
+
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
 	bool loadFromWaveFile(Common::SeekableReadStream *file);
@@ -465,6 +492,16 @@ public:
 	 */
 	ResourceType convertResType(byte type);
 
+	ResourceCachePolicy getCachePolicy() const { return _cachePolicy; }
+	void setCachePolicy(ResourceCachePolicy policy);
+	int getCacheMemoryLimit() const { return _maxMemoryLRU; }
+	void setCacheMemoryLimit(int bytes);
+	int getCacheMemoryUsed() const { return _memoryLRU; }
+	int getCacheMemoryProtected() const { return _memoryProtected; }
+	int getLockedMemory() const { return _memoryLocked; }
+	const ResourceCacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats() { _cacheStats = ResourceCacheStats(); }
+
 protected:
 	bool _detectionMode;
 
@@ -479,7 +516,11 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	int _memoryProtected;	///< Amount of resource bytes in the protected LRU segment
+	Common::List<Resource *> _LRU; ///< Last Resource Used list (probation segment for segmented LRU)
+	Common::List<Resource *> _protectedLRU; ///< Protected segment for segmented LRU
+	ResourceCachePolicy _cachePolicy;
+	ResourceCacheStats _cacheStats;
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
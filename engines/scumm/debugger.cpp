@@ -79,6 +79,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	registerCmd("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
 	registerCmd("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
+	registerCmd("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
 
 	if (_vm->_game.id == GID_LOOM)
 		registerCmd("drafts",  WRAP_METHOD(ScummDebugger, Cmd_PrintDraft));
@@ -322,6 +323,27 @@ bool ScummDebugger::Cmd_ImportRes(int argc, const char** argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager::Stats &stats = _vm->_res->_stats;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			stats = ResourceManager::Stats();
+		} else {
+			debugPrintf("Syntax: resources [reset]\n");
+			return true;
+		}
+	}
+
+	const uint32 requests = stats.hits + stats.misses;
+	debugPrintf("Resource requests: %u, in memory: %u, loaded: %u (hit rate %u%%)\n",
+	            requests, stats.hits, stats.misses, requests ? stats.hits * 100 / requests : 0);
+	debugPrintf("Prefetched: %u, used: %u, expired unused: %u\n",
+	            stats.prefetches, stats.prefetchHits, stats.prefetchesExpired);
+
+	return true;
+}
+
 bool ScummDebugger::Cmd_PrintScript(int argc, const char **argv) {
 	int i;
 	ScriptSlot *ss = _vm->vm.slot;
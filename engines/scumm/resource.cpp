@@ -48,6 +48,7 @@ enum {
 	RF_USAGE_MAX = RF_USAGE,
 
 	RS_MODIFIED = 0x10,
+	RS_PREFETCHED = 0x20,
 	RF_OFFHEAP = 0x40
 };
 
@@ -609,9 +610,16 @@ void ScummEngine::ensureResourceLoaded(ResType type, ResId idx) {
 	if (type != rtCharset && idx == 0)
 		return;
 
-	if (idx <= _res->_types[type].size() && _res->_types[type][idx]._address)
+	if (idx <= _res->_types[type].size() && _res->_types[type][idx]._address) {
+		_res->_stats.hits++;
+		if (_res->_types[type][idx].isPrefetched()) {
+			_res->_types[type][idx].clearPrefetched();
+			_res->_stats.prefetchHits++;
+		}
 		return;
+	}
 
+	_res->_stats.misses++;
 	loadResource(type, idx);
 
 	if (_game.version == 5 && type == rtRoom && (int)idx == _roomResource)
@@ -748,6 +756,11 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 
 	_res->setResourceCounter(type, idx, 1);
 
+	if (_res->_types[type][idx].isPrefetched()) {
+		_res->_types[type][idx].clearPrefetched();
+		_res->_stats.prefetchHits++;
+	}
+
 	debugC(DEBUG_RESOURCE, "getResourceAddress(%s,%d) == %p", nameOfResType(type), idx, (void *)ptr);
 	return ptr;
 }
@@ -856,7 +869,7 @@ void ResourceManager::Resource::nuke() {
 	_address = 0;
 	_size = 0;
 	_flags = 0;
-	_status &= ~RS_MODIFIED;
+	_status &= ~(RS_MODIFIED | RS_PREFETCHED);
 }
 
 ResourceManager::ResTypeData::ResTypeData() {
@@ -1032,6 +1045,18 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+void ResourceManager::Resource::setPrefetched() {
+	_status |= RS_PREFETCHED;
+}
+
+void ResourceManager::Resource::clearPrefetched() {
+	_status &= ~RS_PREFETCHED;
+}
+
+bool ResourceManager::Resource::isPrefetched() const {
+	return (_status & RS_PREFETCHED) != 0;
+}
+
 void ResourceManager::expireResources(uint32 size) {
 	byte best_counter;
 	ResType best_type;
@@ -1071,6 +1096,8 @@ void ResourceManager::expireResources(uint32 size) {
 
 		if (!best_type)
 			break;
+		if (_types[best_type][best_res].isPrefetched())
+			_stats.prefetchesExpired++;
 		nukeResource(best_type, best_res);
 	} while (size + _allocatedSize > _minHeapThreshold);
 
@@ -1083,7 +1110,7 @@ void ResourceManager::freeResources() {
 	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
 		ResId idx = _types[type].size();
 		while (idx-- > 0) {
-			if (isResourceLoaded(type, idx))
+			if (_types[type][idx]._address)
 				nukeResource(type, idx);
 		}
 		_types[type].clear();
@@ -1116,7 +1143,9 @@ void ScummEngine::loadPtrToResource(ResType type, ResId idx, const byte *source)
 bool ResourceManager::isResourceLoaded(ResType type, ResId idx) const {
 	if (!validateResource("isResourceLoaded", type, idx))
 		return false;
-	return _types[type][idx]._address != NULL;
+	// Prefetched resources are not loaded as far as the game is concerned,
+	// until they are used for the first time.
+	return _types[type][idx]._address != NULL && !_types[type][idx].isPrefetched();
 }
 
 void ResourceManager::resourceStats() {
@@ -1136,6 +1165,43 @@ void ResourceManager::resourceStats() {
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
 }
 
+bool ResourceManager::canPrefetch() const {
+	// Leave half of the space between the two heap thresholds for resources
+	// which are loaded on demand, so that prefetching does not cause any of
+	// them to expire.
+	return _allocatedSize < _minHeapThreshold + (_maxHeapThreshold - _minHeapThreshold) / 2;
+}
+
+void ScummEngine::prefetchRoomResources() {
+	static const ResType prefetchTypes[] = { rtCostume, rtScript, rtImage };
+
+	// Old games are small enough to not benefit from this
+	if (_game.features & (GF_SMALL_HEADER | GF_OLD_BUNDLE))
+		return;
+
+	// The data files are laid out so that the costumes, scripts and images
+	// which are first needed in a room are stored in that room's block. The
+	// room's data file has just been opened, so reading them now is cheap,
+	// and avoids seeking back and forth while the room is being set up.
+	const int roomNr = getResourceRoomNr(rtRoom, _roomResource);
+	for (int i = 0; i < ARRAYSIZE(prefetchTypes); i++) {
+		const ResType type = prefetchTypes[i];
+		for (ResId idx = 1; idx < _res->_types[type].size(); idx++) {
+			ResourceManager::Resource &res = _res->_types[type][idx];
+			if (res._roomno != roomNr || res._address || res._roomoffs == RES_INVALID_OFFSET)
+				continue;
+
+			if (!_res->canPrefetch())
+				return;
+
+			if (loadResource(type, idx) && res._address) {
+				res.setPrefetched();
+				_res->_stats.prefetches++;
+			}
+		}
+	}
+}
+
 void ScummEngine_v5::readMAXS(int blockSize) {
 	_numVariables = _fileHandle->readUint16LE();      // 800
 	_fileHandle->readUint16LE();                      // 16
@@ -145,6 +145,10 @@ public:
 		void setOffHeap();
 		void setOnHeap();
 		bool isOffHeap() const;
+
+		void setPrefetched();
+		void clearPrefetched();
+		bool isPrefetched() const;
 	};
 
 	/**
@@ -171,6 +175,26 @@ public:
 	};
 	ResTypeData _types[rtLast + 1];
 
+	/**
+	 * Counters describing how often resources had to be read from the game
+	 * data files. Shown by the "resources" debugger command.
+	 */
+	struct Stats {
+		Stats() : hits(0), misses(0), prefetches(0), prefetchHits(0), prefetchesExpired(0) {}
+
+		/** Number of times ensureResourceLoaded() found the resource in memory. */
+		uint32 hits;
+		/** Number of resources loaded on demand. */
+		uint32 misses;
+		/** Number of resources loaded ahead of use by ScummEngine::prefetchRoomResources(). */
+		uint32 prefetches;
+		/** Number of prefetched resources which were used before being expired. */
+		uint32 prefetchHits;
+		/** Number of prefetched resources which expired without being used. */
+		uint32 prefetchesExpired;
+	};
+	Stats _stats;
+
 protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
@@ -191,6 +215,10 @@ public:
 //	inline Resource &getRes(ResType type, ResId idx) { return _types[type][idx]; }
 //	inline const Resource &getRes(ResType type, ResId idx) const { return _types[type][idx]; }
 
+	/**
+	 * Returns whether the given resource has been loaded. Resources which
+	 * were prefetched, but not used yet, do not count as loaded.
+	 */
 	bool isResourceLoaded(ResType type, ResId idx) const;
 
 	void lock(ResType type, ResId idx);
@@ -225,6 +253,12 @@ public:
 
 	void resourceStats();
 
+	/**
+	 * Returns whether there is enough room left on the heap to load
+	 * resources ahead of use, without causing other resources to expire.
+	 */
+	bool canPrefetch() const;
+
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
@@ -765,6 +765,12 @@ public:
 	byte *getStringAddressVar(int i);
 	void ensureResourceLoaded(ResType type, ResId idx);
 
+	/**
+	 * Loads resources which are stored in the current room's data, and are
+	 * therefore likely to be needed soon, while there is room on the heap.
+	 */
+	void prefetchRoomResources();
+
 protected:
 	int readSoundResource(ResId idx);
 	int readSoundResourceSmallHeader(ResId idx);
@@ -227,7 +227,54 @@ uint RenderedImage::getPixel(int x, int y) {
 // -----------------------------------------------------------------------------
 
 bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, RectangleList *updateRects) {
-	_surface.blit(*_backSurface, posX, posY, (((flipping & 1) ? Graphics::FLIP_V : 0) | ((flipping & 2) ? Graphics::FLIP_H : 0)), pPartRect, color, width, height);
+	const int flip = ((flipping & 1) ? Graphics::FLIP_V : 0) | ((flipping & 2) ? Graphics::FLIP_H : 0);
+
+	if (!updateRects) {
+		_surface.blit(*_backSurface, posX, posY, flip, pPartRect, color, width, height);
+		return true;
+	}
+
+	// Fully transparent, nothing to do
+	if ((color >> 24) == 0)
+		return true;
+
+	// Only redraw the parts of the image which are covered by the update
+	// rects, the rest of the back surface is still up to date.
+	const int partWidth = pPartRect ? pPartRect->width() : _surface.w;
+	const int partHeight = pPartRect ? pPartRect->height() : _surface.h;
+	if (width == -1)
+		width = partWidth;
+	if (height == -1)
+		height = partHeight;
+
+	Graphics::TransparentSurface *src = &_surface;
+	Graphics::TransparentSurface *scaled = nullptr;
+	if (width != partWidth || height != partHeight) {
+		// Scale the image once, instead of once for every update rect. The
+		// part is picked the same way as in TransparentSurface::blit().
+		Graphics::TransparentSurface part(_surface, false);
+		if (pPartRect) {
+			const int xOffset = (flip & Graphics::FLIP_H) ? _surface.w - pPartRect->right : pPartRect->left;
+			const int yOffset = (flip & Graphics::FLIP_V) ? _surface.h - pPartRect->bottom : pPartRect->top;
+			part.setPixels(_surface.getBasePtr(xOffset, yOffset));
+			part.w = partWidth;
+			part.h = partHeight;
+		}
+		src = scaled = part.scale(width, height);
+		scaled->setAlphaMode(_surface.getAlphaMode());
+		pPartRect = nullptr;
+	}
+
+	const Common::Rect dstRect(posX, posY, posX + width, posY + height);
+	for (RectangleList::iterator it = updateRects->begin(); it != updateRects->end(); ++it) {
+		if (dstRect.intersects(*it))
+			src->blitClip(*_backSurface, *it, posX, posY, flip, pPartRect, color);
+	}
+
+	if (scaled) {
+		scaled->free();
+		delete scaled;
+	}
 
 	return true;
 }
@@ -58,6 +58,7 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
 	_dirtyRect = nullptr;
+	_dirtyTilesX = _dirtyTilesY = 0;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -135,6 +136,8 @@ bool BaseRenderOSystem::initRenderer(int width, int height, bool windowed) {
 
 	g_system->showMouse(false);
 
+	initDirtyTiles(_width, _height);
+
 	_renderSurface->create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 	_blankSurface->create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 	_blankSurface->fillRect(Common::Rect(0, 0, _blankSurface->h, _blankSurface->w), _blankSurface->format.ARGBToColor(255, 0, 0, 0));
@@ -154,8 +157,7 @@ bool BaseRenderOSystem::indicatorFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		clearDirtyRects();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -177,7 +179,7 @@ bool BaseRenderOSystem::flip() {
 		while (it != _renderQueue.end()) {
 			if ((*it)->_wantsDraw == false) {
 				RenderTicket *ticket = *it;
-				it = _renderQueue.erase(it);
+				it = dequeueTicket(it);
 				delete ticket;
 			} else {
 				(*it)->_wantsDraw = false;
@@ -193,14 +195,18 @@ bool BaseRenderOSystem::flip() {
 	if (_needsFlip || _disableDirtyRects || screenChanged) {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
+			_frameStats.pixelsUpdated = _renderSurface->w * _renderSurface->h;
 		}
 		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		clearDirtyRects();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
 
+	_frameStats.tickets = _renderQueue.size();
+	_lastFrameStats = _frameStats;
+	_frameStats = RenderStats();
+
 	g_system->updateScreen();
 
 	return STATUS_OK;
@@ -273,7 +279,7 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 	if (_disableDirtyRects) {
 		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
 		ticket->_wantsDraw = true;
-		_renderQueue.push_back(ticket);
+		queueTicket(_renderQueue.end(), ticket);
 		drawFromSurface(ticket);
 		return;
 	}
@@ -285,32 +291,14 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		RenderQueueIterator it = findQueuedTicket(compare);
+		if (it != _renderQueue.end()) {
+			drawFromQueuedTicket(it);
+			return;
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
-	if (!_disableDirtyRects) {
-		drawFromTicket(ticket);
-	} else {
-		ticket->_wantsDraw = true;
-		_renderQueue.push_back(ticket);
-		drawFromSurface(ticket);
-	}
+	drawFromTicket(ticket);
 }
 
 void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
@@ -320,6 +308,8 @@ void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
+	_transformCache.invalidate(surf);
+
 	RenderQueueIterator it;
 	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 		if ((*it)->_owner == surf) {
@@ -334,15 +324,11 @@ void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
 	++_lastFrameIter;
 	// In-order
 	if (_renderQueue.empty() || _lastFrameIter == _renderQueue.end()) {
-		_lastFrameIter--;
-		_renderQueue.push_back(renderTicket);
-		++_lastFrameIter;
+		_lastFrameIter = queueTicket(_renderQueue.end(), renderTicket);
 		addDirtyRect(renderTicket->_dstRect);
 	} else {
 		// Before something
-		RenderQueueIterator pos = _lastFrameIter;
-		_renderQueue.insert(pos, renderTicket);
-		--_lastFrameIter;
+		_lastFrameIter = queueTicket(_lastFrameIter, renderTicket);
 		addDirtyRect(renderTicket->_dstRect);
 	}
 }
@@ -358,19 +344,137 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 		--_lastFrameIter;
 		// Remove the ticket from the list
 		assert(*_lastFrameIter != renderTicket);
-		_renderQueue.erase(ticket);
+		dequeueTicket(ticket);
 		// Is not in order, so readd it as if it was a new ticket
 		drawFromTicket(renderTicket);
 	}
 }
 
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::queueTicket(const RenderQueueIterator &pos, RenderTicket *ticket) {
+	_renderQueue.insert(pos, ticket);
+	RenderQueueIterator it = pos;
+	--it;
+	_ticketIndex[ticket->getHash()].push_back(it);
+	return it;
+}
+
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::dequeueTicket(const RenderQueueIterator &ticket) {
+	TicketIndex::iterator bucket = _ticketIndex.find((*ticket)->getHash());
+	assert(bucket != _ticketIndex.end());
+	Common::Array<RenderQueueIterator> &entries = bucket->_value;
+	for (uint i = 0; i < entries.size(); i++) {
+		if (entries[i] == ticket) {
+			entries.remove_at(i);
+			break;
+		}
+	}
+	if (entries.empty()) {
+		_ticketIndex.erase(bucket);
+	}
+	return _renderQueue.erase(ticket);
+}
+
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::findQueuedTicket(const RenderTicket &compare) {
+	TicketIndex::const_iterator bucket = _ticketIndex.find(compare.getHash());
+	if (bucket != _ticketIndex.end()) {
+		const Common::Array<RenderQueueIterator> &entries = bucket->_value;
+		for (uint i = 0; i < entries.size(); i++) {
+			const RenderTicket *ticket = *entries[i];
+			// The tickets which haven't been drawn yet in this frame are
+			// exactly the ones following _lastFrameIter.
+			if (*ticket == compare && ticket->_isValid && !ticket->_wantsDraw) {
+				return entries[i];
+			}
+		}
+	}
+	return _renderQueue.end();
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
+	Common::Rect clipped(rect);
+	clipped.clip(_renderRect);
+	clipped.clip(_dirtyTileRect);
+	if (clipped.isEmpty()) {
+		return;
+	}
+
 	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
+		_dirtyRect = new Common::Rect(clipped);
 	} else {
-		_dirtyRect->extend(rect);
+		_dirtyRect->extend(clipped);
+	}
+
+	for (int y = clipped.top / kDirtyTileSize; y <= (clipped.bottom - 1) / kDirtyTileSize; y++) {
+		for (int x = clipped.left / kDirtyTileSize; x <= (clipped.right - 1) / kDirtyTileSize; x++) {
+			_dirtyTiles[y * _dirtyTilesX + x] = true;
+		}
+	}
+}
+
+void BaseRenderOSystem::clearDirtyRects() {
+	delete _dirtyRect;
+	_dirtyRect = nullptr;
+	for (uint i = 0; i < _dirtyTiles.size(); i++) {
+		_dirtyTiles[i] = false;
+	}
+}
+
+void BaseRenderOSystem::initDirtyTiles(int width, int height) {
+	if (_dirtyTileRect.width() == width && _dirtyTileRect.height() == height && !_dirtyTiles.empty()) {
+		return;
+	}
+
+	_dirtyTileRect = Common::Rect(width, height);
+	_dirtyTilesX = (width + kDirtyTileSize - 1) / kDirtyTileSize;
+	_dirtyTilesY = (height + kDirtyTileSize - 1) / kDirtyTileSize;
+	_dirtyTiles.resize(_dirtyTilesX * _dirtyTilesY);
+	clearDirtyRects();
+}
+
+void BaseRenderOSystem::getDirtyRects(Common::Array<Common::Rect> &rects) const {
+	rects.clear();
+	// Collect the runs of dirty tiles in each row, and merge each run into
+	// the rect ending right above it, if that one spans the same columns.
+	for (int y = 0; y < _dirtyTilesY; y++) {
+		int x = 0;
+		while (x < _dirtyTilesX) {
+			if (!_dirtyTiles[y * _dirtyTilesX + x]) {
+				x++;
+				continue;
+			}
+			const int start = x;
+			while (x < _dirtyTilesX && _dirtyTiles[y * _dirtyTilesX + x]) {
+				x++;
+			}
+
+			uint i;
+			for (i = 0; i < rects.size(); i++) {
+				if (rects[i].bottom == y && rects[i].left == start && rects[i].right == x) {
+					rects[i].bottom = y + 1;
+					break;
+				}
+			}
+			if (i == rects.size()) {
+				if (rects.size() == kMaxDirtyRects) {
+					rects.clear();
+					rects.push_back(*_dirtyRect);
+					return;
+				}
+				rects.push_back(Common::Rect(start, y, x, y + 1));
+			}
+		}
+	}
+
+	// Convert from tiles to pixels. The tiles may stick out of the
+	// actually dirty area, so cut them down to its bounding rect.
+	for (uint i = 0; i < rects.size(); i++) {
+		Common::Rect &rect = rects[i];
+		rect.left *= kDirtyTileSize;
+		rect.top *= kDirtyTileSize;
+		rect.right *= kDirtyTileSize;
+		rect.bottom *= kDirtyTileSize;
+		rect.clip(*_dirtyRect);
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -383,7 +487,7 @@ void BaseRenderOSystem::drawTickets() {
 		if ((*it)->_wantsDraw == false) {
 			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
+			it = dequeueTicket(it);
 			delete ticket;
 		} else {
 			++it;
@@ -399,43 +503,61 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
+	Common::Array<Common::Rect> dirtyRects;
+	getDirtyRects(dirtyRects);
+	_frameStats.dirtyRects = dirtyRects.size();
+
 	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
+	const RenderTicket *opaqueTicket = nullptr;
 	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+		opaqueTicket = *it;
+	}
+	for (uint i = 0; i < dirtyRects.size(); i++) {
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+		if (!opaqueTicket || !opaqueTicket->_dstRect.contains(dirtyRects[i])) {
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(dirtyRects[i], _clearColor);
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
 	}
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
 		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+			bool drawn = false;
+			for (uint i = 0; i < dirtyRects.size(); i++) {
+				if (!ticket->_dstRect.intersects(dirtyRects[i])) {
+					continue;
+				}
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(dirtyRects[i]);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				drawn = true;
+			}
+			if (drawn) {
+				_frameStats.ticketsDrawn++;
+				_needsFlip = true;
+			}
 		}
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
 		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+	for (uint i = 0; i < dirtyRects.size(); i++) {
+		const Common::Rect &rect = dirtyRects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(rect.left, rect.top), _renderSurface->pitch, rect.left, rect.top, rect.width(), rect.height());
+		_frameStats.pixelsUpdated += rect.width() * rect.height();
+	}
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -443,7 +565,7 @@ void BaseRenderOSystem::drawTickets() {
 		if ((*it)->_isValid == false) {
 			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
+			it = dequeueTicket(it);
 			delete ticket;
 		} else {
 			++it;
@@ -455,10 +577,16 @@ void BaseRenderOSystem::drawTickets() {
 // Replacement for SDL2's SDL_RenderCopy
 void BaseRenderOSystem::drawFromSurface(RenderTicket *ticket) {
 	ticket->drawToSurface(_renderSurface);
+
+	Common::Rect drawn(ticket->_dstRect);
+	drawn.clip(_renderRect);
+	_frameStats.ticketsDrawn++;
+	_frameStats.pixelsDrawn += drawn.width() * drawn.height();
 }
 
 void BaseRenderOSystem::drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect) {
 	ticket->drawToSurface(_renderSurface, dstRect, clipRect);
+	_frameStats.pixelsDrawn += dstRect->width() * dstRect->height();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -571,6 +699,7 @@ void BaseRenderOSystem::endSaveLoad() {
 		it = _renderQueue.erase(it);
 		delete ticket;
 	}
+	_ticketIndex.clear();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
@@ -30,14 +30,38 @@
 #define WINTERMUTE_BASE_RENDERER_SDL_H
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
+#include "engines/wintermute/base/gfx/osystem/transformed_surface_cache.h"
 #include "common/rect.h"
 #include "graphics/surface.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "graphics/transform_struct.h"
 
 namespace Wintermute {
 class BaseSurfaceOSystem;
 class RenderTicket;
+
+/**
+ * Counters describing the work done by the renderer for one frame.
+ *
+ * @see BaseRenderOSystem::getStats()
+ */
+struct RenderStats {
+	RenderStats() : tickets(0), ticketsDrawn(0), dirtyRects(0), pixelsDrawn(0), pixelsUpdated(0) {}
+
+	/** Number of tickets in the render queue. */
+	uint32 tickets;
+	/** Number of tickets which were (partially) redrawn. */
+	uint32 ticketsDrawn;
+	/** Number of separate regions which were redrawn. */
+	uint32 dirtyRects;
+	/** Number of pixels blitted from tickets to the render surface. */
+	uint32 pixelsDrawn;
+	/** Number of pixels copied from the render surface to the screen. */
+	uint32 pixelsUpdated;
+};
+
 /**
  * A 2D-renderer implementation for WME.
  * This renderer makes use of a "ticket"-system, where all draw-calls
@@ -53,6 +77,9 @@ class RenderTicket;
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
  *
+ * The dirty areas are tracked on a grid of tiles, so that changes in distant
+ * parts of the screen don't cause everything in between to be redrawn.
+ *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accomodate situations with large enough amounts of draw calls,
  * that there will be too much overhead involved with comparing the generated tickets.
@@ -80,6 +107,11 @@ public:
 
 	void invalidateTicket(RenderTicket *renderTicket);
 	void invalidateTicketsFromSurface(BaseSurfaceOSystem *surf);
+	TransformedSurfaceCache &getTransformCache() { return _transformCache; }
+	/**
+	 * Returns the statistics gathered while rendering the last frame.
+	 */
+	const RenderStats &getStats() const { return _lastFrameStats; }
 	/**
 	 * Insert a new ticket into the queue, adding a dirty rect
 	 * @param renderTicket the ticket to be added.
@@ -113,11 +145,46 @@ public:
 	void drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
 	BaseSurface *createSurface() override;
 private:
+	enum {
+		kDirtyTileSize = 32,
+		kMaxDirtyRects = 32
+	};
+
 	/**
 	 * Mark a specified rect of the screen as dirty.
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Mark the whole screen as clean.
+	 */
+	void clearDirtyRects();
+	/**
+	 * Size the tile grid to cover a screen of the given size. Only rebuilds
+	 * the grid (and marks everything clean) if the size actually changed.
+	 */
+	void initDirtyTiles(int width, int height);
+	/**
+	 * Merge the dirty tiles into as few rects as easily possible. Falls back
+	 * to the bounding rect of all dirty areas if that gives too many rects.
+	 */
+	void getDirtyRects(Common::Array<Common::Rect> &rects) const;
+	/**
+	 * Insert a ticket into the queue (and the ticket index) before pos.
+	 * @return iterator pointing to the inserted ticket
+	 */
+	RenderQueueIterator queueTicket(const RenderQueueIterator &pos, RenderTicket *ticket);
+	/**
+	 * Remove a ticket from the queue (and the ticket index), without deleting it.
+	 * @return iterator pointing to the ticket following the removed one
+	 */
+	RenderQueueIterator dequeueTicket(const RenderQueueIterator &ticket);
+	/**
+	 * Find a valid ticket from last frame which is equal to compare, and
+	 * hasn't been drawn in this frame yet.
+	 * @return iterator pointing to the ticket, or the end of the queue if there is none
+	 */
+	RenderQueueIterator findQueuedTicket(const RenderTicket &compare);
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
@@ -127,7 +194,20 @@ private:
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
 	Common::Rect *_dirtyRect;
+	/** One flag per tile of the screen, set for the tiles which need to be redrawn. */
+	Common::Array<bool> _dirtyTiles;
+	/** The full screen covered by the tile grid; unlike _renderRect it is never offset by setViewport(). */
+	Common::Rect _dirtyTileRect;
+	int _dirtyTilesX;
+	int _dirtyTilesY;
 	Common::List<RenderTicket *> _renderQueue;
+	/** The queued tickets, by RenderTicket::getHash(). */
+	typedef Common::HashMap<uint32, Common::Array<RenderQueueIterator> > TicketIndex;
+	TicketIndex _ticketIndex;
+	TransformedSurfaceCache _transformCache;
+
+	RenderStats _frameStats;
+	RenderStats _lastFrameStats;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
@@ -30,6 +30,7 @@
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/gfx/osystem/render_ticket.h"
 #include "engines/wintermute/base/gfx/osystem/base_surface_osystem.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "graphics/transform_tools.h"
 #include "common/textconsole.h"
 
@@ -43,12 +44,29 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	_wantsDraw(true),
 	_transform(transform) {
 	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
-		assert(_surface->format.bytesPerPixel == 4);
+		const bool rotate = (_transform._angle != Graphics::kDefaultAngle);
+		const bool scale = !rotate &&
+			(dstRect->width() != srcRect->width() || dstRect->height() != srcRect->height()) &&
+			_transform._numTimesX * _transform._numTimesY == 1;
+
+		// Reuse the result of an earlier identical transform, if possible
+		TransformedSurfaceCache *cache = nullptr;
+		bool bilinear = false;
+		if (owner && (rotate || scale)) {
+			bilinear = owner->_gameRef->getBilinearFiltering();
+			cache = &static_cast<BaseRenderOSystem *>(owner->_gameRef->_renderer)->getTransformCache();
+			_surface = cache->get(TransformedSurfaceCache::Key(owner, *srcRect, *dstRect, transform, bilinear));
+			if (_surface) {
+				return;
+			}
+		}
+
+		Graphics::Surface *surface = new Graphics::Surface();
+		surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+		assert(surface->format.bytesPerPixel == 4);
 		// Get a clipped copy of the surface
-		for (int i = 0; i < _surface->h; i++) {
-			memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
+		for (int i = 0; i < surface->h; i++) {
+			memcpy(surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * surface->format.bytesPerPixel);
 		}
 		// Then scale it if necessary
 		//
@@ -58,41 +76,38 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// NB: Mirroring and rotation are probably done in the wrong order.
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
-		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::TransparentSurface src(*_surface, false);
+		if (rotate) {
+			Graphics::TransparentSurface src(*surface, false);
 			Graphics::Surface *temp;
-			if (owner->_gameRef->getBilinearFiltering()) {
+			if (bilinear) {
 				temp = src.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
 			} else {
 				temp = src.rotoscaleT<Graphics::FILTER_NEAREST>(transform);
 			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
-		} else if ((dstRect->width() != srcRect->width() ||
-					dstRect->height() != srcRect->height()) &&
-					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::TransparentSurface src(*_surface, false);
+			surface->free();
+			delete surface;
+			surface = temp;
+		} else if (scale) {
+			Graphics::TransparentSurface src(*surface, false);
 			Graphics::Surface *temp;
-			if (owner->_gameRef->getBilinearFiltering()) {
+			if (bilinear) {
 				temp = src.scaleT<Graphics::FILTER_BILINEAR>(dstRect->width(), dstRect->height());
 			} else {
 				temp = src.scaleT<Graphics::FILTER_NEAREST>(dstRect->width(), dstRect->height());
 			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			surface->free();
+			delete surface;
+			surface = temp;
+		}
+		_surface = Common::SharedPtr<Graphics::Surface>(surface, Graphics::SharedPtrSurfaceDeleter());
+
+		if (cache) {
+			cache->put(TransformedSurfaceCache::Key(owner, *srcRect, *dstRect, transform, bilinear), _surface);
 		}
-	} else {
-		_surface = nullptr;
 	}
 }
 
 RenderTicket::~RenderTicket() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
 }
 
 bool RenderTicket::operator==(const RenderTicket &t) const {
@@ -106,6 +121,19 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+uint32 RenderTicket::getHash() const {
+	// Only covers the fields which usually differ between tickets
+	uint32 hash = (uint32)(size_t)_owner;
+	hash = hash * 31 + (uint16)_srcRect.left;
+	hash = hash * 31 + (uint16)_srcRect.top;
+	hash = hash * 31 + (uint16)_dstRect.left;
+	hash = hash * 31 + (uint16)_dstRect.top;
+	hash = hash * 31 + (uint16)_dstRect.width();
+	hash = hash * 31 + (uint16)_dstRect.height();
+	hash = hash * 31 + (uint32)_transform._angle;
+	return hash;
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	Graphics::TransparentSurface src(*getSurface(), false);
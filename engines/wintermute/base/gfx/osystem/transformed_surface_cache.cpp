@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/wintermute/base/gfx/osystem/transformed_surface_cache.h"
+
+namespace Wintermute {
+
+TransformedSurfaceCache::Key::Key(const BaseSurfaceOSystem *owner, const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, bool bilinear) :
+	_owner(owner),
+	_srcRect(srcRect),
+	_width(dstRect.width()),
+	_height(dstRect.height()),
+	_zoom(transform._zoom),
+	_hotspot(transform._hotspot),
+	_angle(transform._angle),
+	_bilinear(bilinear) {
+}
+
+bool TransformedSurfaceCache::Key::operator==(const Key &other) const {
+	return _owner == other._owner &&
+		_srcRect == other._srcRect &&
+		_width == other._width &&
+		_height == other._height &&
+		_zoom == other._zoom &&
+		_hotspot == other._hotspot &&
+		_angle == other._angle &&
+		_bilinear == other._bilinear;
+}
+
+TransformedSurfaceCache::TransformedSurfaceCache() : _pixels(0) {
+}
+
+Common::SharedPtr<Graphics::Surface> TransformedSurfaceCache::get(const Key &key) {
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->_key == key) {
+			// Move it to the front, so that it is found quickly next frame
+			if (it != _entries.begin()) {
+				_entries.push_front(*it);
+				_entries.erase(it);
+			}
+			return _entries.front()._surface;
+		}
+	}
+
+	return Common::SharedPtr<Graphics::Surface>();
+}
+
+void TransformedSurfaceCache::put(const Key &key, const Common::SharedPtr<Graphics::Surface> &surface) {
+	const uint32 pixels = surface->w * surface->h;
+	if (pixels > kMaxPixels) {
+		return;
+	}
+
+	_entries.push_front(Entry(key, surface));
+	_pixels += pixels;
+
+	while (_entries.size() > kMaxEntries || _pixels > kMaxPixels) {
+		const Graphics::Surface *oldest = _entries.back()._surface.get();
+		_pixels -= oldest->w * oldest->h;
+		_entries.pop_back();
+	}
+}
+
+void TransformedSurfaceCache::invalidate(const BaseSurfaceOSystem *owner) {
+	EntryList::iterator it = _entries.begin();
+	while (it != _entries.end()) {
+		if (it->_key._owner == owner) {
+			const Graphics::Surface *surface = it->_surface.get();
+			_pixels -= surface->w * surface->h;
+			it = _entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void TransformedSurfaceCache::clear() {
+	_entries.clear();
+	_pixels = 0;
+}
+
+} // End of namespace Wintermute
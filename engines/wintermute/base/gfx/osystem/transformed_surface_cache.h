@@ -0,0 +1,112 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef WINTERMUTE_TRANSFORMED_SURFACE_CACHE_H
+#define WINTERMUTE_TRANSFORMED_SURFACE_CACHE_H
+
+#include "graphics/surface.h"
+#include "graphics/transform_struct.h"
+#include "common/list.h"
+#include "common/ptr.h"
+#include "common/rect.h"
+
+namespace Wintermute {
+
+class BaseSurfaceOSystem;
+
+/**
+ * Keeps the results of recently rotated or scaled sprites around.
+ *
+ * Zoomed actors and rotating interface elements are usually drawn with the
+ * same transform for many frames in a row. Their render tickets still
+ * differ between frames when the sprite moves, when the draw order changes
+ * or when dirty rects are disabled. Transforming a sprite (particularly with
+ * bilinear filtering) is much more expensive than drawing it, so new
+ * tickets share the surface transformed for an earlier one instead.
+ */
+class TransformedSurfaceCache {
+public:
+	/**
+	 * Identifies a transformed surface by everything that affects its
+	 * pixels. Position, colour modulation and blend mode only matter when
+	 * drawing it.
+	 */
+	struct Key {
+		Key(const BaseSurfaceOSystem *owner, const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, bool bilinear);
+
+		bool operator==(const Key &other) const;
+
+		const BaseSurfaceOSystem *_owner;
+		Common::Rect _srcRect;
+		int16 _width;
+		int16 _height;
+		Common::Point _zoom;
+		Common::Point _hotspot;
+		int32 _angle;
+		bool _bilinear;
+	};
+
+	TransformedSurfaceCache();
+
+	/**
+	 * Looks up a transformed surface.
+	 * @return the surface, or a null pointer if it is not cached
+	 */
+	Common::SharedPtr<Graphics::Surface> get(const Key &key);
+
+	/**
+	 * Adds a transformed surface, dropping the least recently used ones if
+	 * the cache grows too large.
+	 */
+	void put(const Key &key, const Common::SharedPtr<Graphics::Surface> &surface);
+
+	/**
+	 * Drops all transformed versions of a surface, e.g. because its pixels
+	 * changed.
+	 */
+	void invalidate(const BaseSurfaceOSystem *owner);
+
+	void clear();
+
+private:
+	enum {
+		kMaxEntries = 64,
+		kMaxPixels = 2 * 1024 * 1024
+	};
+
+	struct Entry {
+		Entry(const Key &key, const Common::SharedPtr<Graphics::Surface> &surface) : _key(key), _surface(surface) {}
+
+		Key _key;
+		Common::SharedPtr<Graphics::Surface> _surface;
+	};
+
+	typedef Common::List<Entry> EntryList;
+
+	/** The cached surfaces, most recently used first. */
+	EntryList _entries;
+	uint32 _pixels;
+};
+
+} // End of namespace Wintermute
+
+#endif
@@ -23,6 +23,8 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -36,6 +38,7 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("render_stats", WRAP_METHOD(Console, Cmd_RenderStats));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -341,6 +344,22 @@ bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_RenderStats(int argc, const char **argv) {
+	if (!_engineRef->_game || !_engineRef->_game->_renderer) {
+		debugPrintf("No renderer active\n");
+		return true;
+	}
+
+	const RenderStats &stats = static_cast<BaseRenderOSystem *>(_engineRef->_game->_renderer)->getStats();
+	debugPrintf("Last frame:\n");
+	debugPrintf("  Tickets queued:  %d\n", stats.tickets);
+	debugPrintf("  Tickets drawn:   %d\n", stats.ticketsDrawn);
+	debugPrintf("  Dirty rects:     %d\n", stats.dirtyRects);
+	debugPrintf("  Pixels drawn:    %d\n", stats.pixelsDrawn);
+	debugPrintf("  Pixels updated:  %d\n", stats.pixelsUpdated);
+	return true;
+}
+
 
 bool Console::Cmd_SourcePath(int argc, const char **argv) {
 	if (argc != 2) {
@@ -34,6 +34,14 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 	assert(numRows != 0 && numColumns != 0);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+	_sourceOffsets = new uint32[numRows * numColumns];
+	_sourceFractions = new uint16[numRows * numColumns];
+	_bilinearFiltering = false;
+
+	for (uint i = 0; i < numRows * numColumns; ++i) {
+		_sourceOffsets[i] = i;
+		_sourceFractions[i] = 0;
+	}
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -41,6 +49,8 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 
 RenderTable::~RenderTable() {
 	delete[] _internalBuffer;
+	delete[] _sourceOffsets;
+	delete[] _sourceFractions;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -82,45 +92,78 @@ const Common::Point RenderTable::convertWarpedCoordToFlatCoord(const Common::Poi
 }
 
 void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect) {
-	uint32 destOffset = 0;
-
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+		const uint32 *sourceOffsets = _sourceOffsets + y * _numColumns + subRect.left;
 
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-		}
+		for (int16 x = 0; x < subRect.width(); ++x)
+			destBuffer[x] = sourceBuffer[sourceOffsets[x]];
 
-		destOffset += destWidth;
+		destBuffer += destWidth;
 	}
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
-
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
+	const uint16 *sourceBuffer = (const uint16 *)srcBuf->getPixels();
 	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
 
+	if (_bilinearFiltering) {
+		mutateImageBilinear(destBuffer, sourceBuffer, srcBuf->w, srcBuf->h, srcBuf->format);
+		return;
+	}
+
+	// The source offsets are precalculated, so this is a plain gather
 	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+		const uint32 *sourceOffsets = _sourceOffsets + y * _numColumns;
+
+		for (int16 x = 0; x < srcBuf->w; ++x)
+			destBuffer[x] = sourceBuffer[sourceOffsets[x]];
 
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+		destBuffer += srcBuf->w;
+	}
+}
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+// The red and blue components of a 555 or 565 pixel stay in place, the green
+// component is moved to the upper half. This leaves enough room above each
+// component to multiply it with a 5 bit weight.
+static FORCEINLINE uint32 spreadPixel(uint16 pixel, uint32 rbMask, uint32 gMask) {
+	return (pixel & rbMask) | ((pixel & gMask) << 16);
+}
+
+static FORCEINLINE uint32 interpolateSpread(uint32 a, uint32 b, uint32 weight, uint32 mask) {
+	return ((a * (32 - weight) + b * weight) >> 5) & mask;
+}
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
+void RenderTable::mutateImageBilinear(uint16 *destBuffer, const uint16 *sourceBuffer, uint32 width, uint32 height, const Graphics::PixelFormat &format) {
+	assert(format.bytesPerPixel == 2);
+	const uint32 rbMask = (format.rMax() << format.rShift) | (format.bMax() << format.bShift);
+	const uint32 gMask = format.gMax() << format.gShift;
+	const uint32 mask = rbMask | (gMask << 16);
+
+	for (uint32 y = 0; y < height; ++y) {
+		const uint32 *sourceOffsets = _sourceOffsets + y * _numColumns;
+		const uint16 *sourceFractions = _sourceFractions + y * _numColumns;
+
+		for (uint32 x = 0; x < width; ++x) {
+			const uint16 *source = sourceBuffer + sourceOffsets[x];
+			const uint32 fractionX = sourceFractions[x] & 0xFF;
+			const uint32 fractionY = sourceFractions[x] >> 8;
+
+			// The fractions are zero at the right and bottom edges of the
+			// image, so the neighbours are only read when they exist
+			uint32 color = spreadPixel(source[0], rbMask, gMask);
+			if (fractionX)
+				color = interpolateSpread(color, spreadPixel(source[1], rbMask, gMask), fractionX, mask);
+			if (fractionY) {
+				uint32 below = spreadPixel(source[_numColumns], rbMask, gMask);
+				if (fractionX)
+					below = interpolateSpread(below, spreadPixel(source[_numColumns + 1], rbMask, gMask), fractionX, mask);
+				color = interpolateSpread(color, below, fractionY, mask);
+			}
+
+			destBuffer[x] = (color & rbMask) | ((color >> 16) & gMask);
 		}
+
+		destBuffer += width;
 	}
 }
 
@@ -154,20 +197,24 @@ void RenderTable::generatePanoramaLookupTable() {
 
 		// To get x in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _panoramaOptions.linearScale
-		int32 xInCylinderCoords = int32(floor((cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth));
+		float xInCylinder = (cylinderRadius * _panoramaOptions.linearScale * alpha) + halfWidth;
+		int32 xInCylinderCoords = int32(floor(xInCylinder));
 
 		float cosAlpha = cos(alpha);
 
 		for (uint y = 0; y < _numRows; ++y) {
 			// To calculate y in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 yInCylinderCoords = int32(floor(halfHeight + ((float)y - halfHeight) * cosAlpha));
+			float yInCylinder = halfHeight + ((float)y - halfHeight) * cosAlpha;
+			int32 yInCylinderCoords = int32(floor(yInCylinder));
 
 			uint32 index = y * _numColumns + x;
 
 			// Only store the (x,y) offsets instead of the absolute positions
 			_internalBuffer[index].x = xInCylinderCoords - x;
 			_internalBuffer[index].y = yInCylinderCoords - y;
+
+			storeOffset(x, y, xInCylinder, yInCylinder);
 		}
 	}
 }
@@ -188,7 +235,8 @@ void RenderTable::generateTiltLookupTable() {
 
 		// To get y in cylinder coordinates, we just need to calculate the arc length
 		// We also scale it by _tiltOptions.linearScale
-		int32 yInCylinderCoords = int32(floor((cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight));
+		float yInCylinder = (cylinderRadius * _tiltOptions.linearScale * alpha) + halfHeight;
+		int32 yInCylinderCoords = int32(floor(yInCylinder));
 
 		float cosAlpha = cos(alpha);
 		uint32 columnIndex = y * _numColumns;
@@ -196,17 +244,37 @@ void RenderTable::generateTiltLookupTable() {
 		for (uint x = 0; x < _numColumns; ++x) {
 			// To calculate x in cylinder coordinates, we can do similar triangles comparison,
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
-			int32 xInCylinderCoords = int32(floor(halfWidth + ((float)x - halfWidth) * cosAlpha));
+			float xInCylinder = halfWidth + ((float)x - halfWidth) * cosAlpha;
+			int32 xInCylinderCoords = int32(floor(xInCylinder));
 
 			uint32 index = columnIndex + x;
 
 			// Only store the (x,y) offsets instead of the absolute positions
 			_internalBuffer[index].x = xInCylinderCoords - x;
 			_internalBuffer[index].y = yInCylinderCoords - y;
+
+			storeOffset(x, y, xInCylinder, yInCylinder);
 		}
 	}
 }
 
+void RenderTable::storeOffset(uint x, uint y, float sourceX, float sourceY) {
+	uint32 index = y * _numColumns + x;
+	uint32 flatX = x + _internalBuffer[index].x;
+	uint32 flatY = y + _internalBuffer[index].y;
+
+	_sourceOffsets[index] = flatY * _numColumns + flatX;
+
+	// Drop the fractions towards pixels outside of the image
+	uint32 fractionX = 0;
+	uint32 fractionY = 0;
+	if (flatX + 1 < _numColumns)
+		fractionX = MIN<uint32>((uint32)((sourceX - floor(sourceX)) * 32.0f), 31);
+	if (flatY + 1 < _numRows)
+		fractionY = MIN<uint32>((uint32)((sourceY - floor(sourceY)) * 32.0f), 31);
+	_sourceFractions[index] = fractionX | (fractionY << 8);
+}
+
 void RenderTable::setPanoramaFoV(float fov) {
 	assert(fov > 0.0f);
 
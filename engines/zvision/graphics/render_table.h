@@ -43,6 +43,14 @@ public:
 private:
 	uint _numColumns, _numRows;
 	Common::Point *_internalBuffer;
+	/** Index of the source pixel for each pixel, i.e. _internalBuffer applied */
+	uint32 *_sourceOffsets;
+	/**
+	 * Sub-pixel position of the source of each pixel, in 1/32 pixel: x in the
+	 * low byte, y in the high byte. Zero in the direction of an image edge.
+	 */
+	uint16 *_sourceFractions;
+	bool _bilinearFiltering;
 	RenderState _renderState;
 
 	struct {
@@ -65,6 +73,9 @@ public:
 		return _renderState;
 	}
 	void setRenderState(RenderState newState);
+	void setBilinearFiltering(bool enable) {
+		_bilinearFiltering = enable;
+	}
 
 	const Common::Point convertWarpedCoordToFlatCoord(const Common::Point &point);
 
@@ -90,6 +101,8 @@ public:
 private:
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
+	void storeOffset(uint x, uint y, float sourceX, float sourceY);
+	void mutateImageBilinear(uint16 *destBuffer, const uint16 *sourceBuffer, uint32 width, uint32 height, const Graphics::PixelFormat &format);
 };
 
 } // End of namespace ZVision
@@ -136,6 +136,8 @@ void ZVision::registerDefaultSettings() {
 				ConfMan.registerDefault(settingsKeys[i].name, settingsKeys[i].defaultBoolValue);
 		}
 	}
+
+	ConfMan.registerDefault("bilinearpanorama", false);
 }
 
 void ZVision::loadSettings() {
@@ -219,6 +221,8 @@ void ZVision::initialize() {
 
 	loadSettings();
 
+	_renderManager->getRenderTable()->setBilinearFiltering(ConfMan.getBool("bilinearpanorama"));
+
 #ifndef USE_MPEG2
 	// libmpeg2 not loaded, disable the MPEG2 movies option
 	_scriptManager->setStateValue(StateKey_MPEGMovies, 2);
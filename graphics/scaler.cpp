@@ -327,7 +327,49 @@ void TV2xTemplate(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 ds
 	uint16 *q = (uint16 *)dstPtr;
 
 	while (height--) {
-		for (int i = 0, j = 0; i < width; ++i, j += 2) {
+		int i = 0;
+
+		// The dimmed line scales every color component by 7/8, which is the
+		// high half of a multiplication by 7/8 * 65536 on the masked pixel.
+#if defined(SCALER_USE_SSE2)
+		const __m128i redBlueMask = _mm_set1_epi16((int16)ColorMask::kRedBlueMask);
+		const __m128i greenMask = _mm_set1_epi16((int16)ColorMask::kGreenMask);
+		const __m128i sevenEighths = _mm_set1_epi16((int16)0xE000);
+		for (; i + 8 <= width; i += 8) {
+			const __m128i p1 = _mm_loadu_si128((const __m128i *)(p + i));
+			const __m128i rb = _mm_and_si128(_mm_mulhi_epu16(_mm_and_si128(p1, redBlueMask), sevenEighths), redBlueMask);
+			const __m128i g = _mm_and_si128(_mm_mulhi_epu16(_mm_and_si128(p1, greenMask), sevenEighths), greenMask);
+			const __m128i pi = _mm_or_si128(rb, g);
+
+			_mm_storeu_si128((__m128i *)(q + 2 * i), _mm_unpacklo_epi16(p1, p1));
+			_mm_storeu_si128((__m128i *)(q + 2 * i + 8), _mm_unpackhi_epi16(p1, p1));
+			_mm_storeu_si128((__m128i *)(q + 2 * i + nextlineDst), _mm_unpacklo_epi16(pi, pi));
+			_mm_storeu_si128((__m128i *)(q + 2 * i + nextlineDst + 8), _mm_unpackhi_epi16(pi, pi));
+		}
+#elif defined(SCALER_USE_NEON)
+		const uint16x8_t redBlueMask = vdupq_n_u16(ColorMask::kRedBlueMask);
+		const uint16x8_t greenMask = vdupq_n_u16(ColorMask::kGreenMask);
+		const uint16x4_t sevenEighths = vdup_n_u16(0xE000);
+		for (; i + 8 <= width; i += 8) {
+			const uint16x8_t p1 = vld1q_u16(p + i);
+			const uint16x8_t rb = vandq_u16(p1, redBlueMask);
+			const uint16x8_t g = vandq_u16(p1, greenMask);
+			const uint16x8_t rb7 = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(rb), sevenEighths), 16),
+			                                    vshrn_n_u32(vmull_u16(vget_high_u16(rb), sevenEighths), 16));
+			const uint16x8_t g7 = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(g), sevenEighths), 16),
+			                                   vshrn_n_u32(vmull_u16(vget_high_u16(g), sevenEighths), 16));
+			const uint16x8_t pi = vorrq_u16(vandq_u16(rb7, redBlueMask), vandq_u16(g7, greenMask));
+
+			const uint16x8x2_t line0 = vzipq_u16(p1, p1);
+			const uint16x8x2_t line1 = vzipq_u16(pi, pi);
+			vst1q_u16(q + 2 * i, line0.val[0]);
+			vst1q_u16(q + 2 * i + 8, line0.val[1]);
+			vst1q_u16(q + 2 * i + nextlineDst, line1.val[0]);
+			vst1q_u16(q + 2 * i + nextlineDst + 8, line1.val[1]);
+		}
+#endif
+
+		for (int j = 2 * i; i < width; ++i, j += 2) {
 			uint16 p1 = *(p + i);
 			uint32 pi;
 
@@ -26,6 +26,14 @@
 #include "common/scummsys.h"
 #include "graphics/colormasks.h"
 
+#if defined(__SSE2__)
+#define SCALER_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SCALER_USE_NEON
+#include <arm_neon.h>
+#endif
+
 
 /**
  * Interpolate two 16 bit pixel *pairs* at once with equal weights 1.
@@ -218,4 +226,59 @@ static inline bool diffYUV(int yuv1, int yuv2) {
 */
 }
 
+/**
+ * Compute the neighbourhood pattern used by the hq scaler family: bit n is
+ * set if the n-th neighbour (in the order w1, w2, w3, w4, w6, w7, w8, w9)
+ * differs from the center pixel w5 according to diffYUV.
+ *
+ * The vector versions compare all eight neighbours at once, on the byte
+ * wise Y, U and V components, and yield exactly the same pattern.
+ */
+static inline int hqxPattern(const uint32 *yuvTable, int w1, int w2, int w3, int w4, int w5, int w6, int w7, int w8, int w9) {
+#if defined(SCALER_USE_SSE2)
+	// Per byte thresholds for V, U and Y (see diffYUV)
+	const __m128i threshold = _mm_set1_epi32(0x00300706);
+	const __m128i center = _mm_set1_epi32(yuvTable[w5]);
+	const __m128i n0 = _mm_set_epi32(yuvTable[w4], yuvTable[w3], yuvTable[w2], yuvTable[w1]);
+	const __m128i n1 = _mm_set_epi32(yuvTable[w9], yuvTable[w8], yuvTable[w7], yuvTable[w6]);
+
+	const __m128i d0 = _mm_subs_epu8(_mm_or_si128(_mm_subs_epu8(center, n0), _mm_subs_epu8(n0, center)), threshold);
+	const __m128i d1 = _mm_subs_epu8(_mm_or_si128(_mm_subs_epu8(center, n1), _mm_subs_epu8(n1, center)), threshold);
+
+	// Lanes where no component exceeds its threshold are equal to zero
+	const __m128i same0 = _mm_cmpeq_epi32(d0, _mm_setzero_si128());
+	const __m128i same1 = _mm_cmpeq_epi32(d1, _mm_setzero_si128());
+	return ~(_mm_movemask_ps(_mm_castsi128_ps(same0)) | (_mm_movemask_ps(_mm_castsi128_ps(same1)) << 4)) & 0xFF;
+#elif defined(SCALER_USE_NEON)
+	static const uint32 bits0[4] = { 0x01, 0x02, 0x04, 0x08 };
+	static const uint32 bits1[4] = { 0x10, 0x20, 0x40, 0x80 };
+	const uint32 yuv0[4] = { yuvTable[w1], yuvTable[w2], yuvTable[w3], yuvTable[w4] };
+	const uint32 yuv1[4] = { yuvTable[w6], yuvTable[w7], yuvTable[w8], yuvTable[w9] };
+
+	const uint8x16_t threshold = vreinterpretq_u8_u32(vdupq_n_u32(0x00300706));
+	const uint8x16_t center = vreinterpretq_u8_u32(vdupq_n_u32(yuvTable[w5]));
+	const uint8x16_t d0 = vcgtq_u8(vabdq_u8(center, vreinterpretq_u8_u32(vld1q_u32(yuv0))), threshold);
+	const uint8x16_t d1 = vcgtq_u8(vabdq_u8(center, vreinterpretq_u8_u32(vld1q_u32(yuv1))), threshold);
+
+	// Lanes where any component exceeds its threshold are non-zero
+	const uint32x4_t m0 = vandq_u32(vtstq_u32(vreinterpretq_u32_u8(d0), vreinterpretq_u32_u8(d0)), vld1q_u32(bits0));
+	const uint32x4_t m1 = vandq_u32(vtstq_u32(vreinterpretq_u32_u8(d1), vreinterpretq_u32_u8(d1)), vld1q_u32(bits1));
+	const uint32x4_t m = vorrq_u32(m0, m1);
+	const uint32x2_t m2 = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+	return vget_lane_u32(vorr_u32(m2, vrev64_u32(m2)), 0);
+#else
+	int pattern = 0;
+	const int yuv5 = yuvTable[w5];
+	if (w5 != w1 && diffYUV(yuv5, yuvTable[w1])) pattern |= 0x0001;
+	if (w5 != w2 && diffYUV(yuv5, yuvTable[w2])) pattern |= 0x0002;
+	if (w5 != w3 && diffYUV(yuv5, yuvTable[w3])) pattern |= 0x0004;
+	if (w5 != w4 && diffYUV(yuv5, yuvTable[w4])) pattern |= 0x0008;
+	if (w5 != w6 && diffYUV(yuv5, yuvTable[w6])) pattern |= 0x0010;
+	if (w5 != w7 && diffYUV(yuv5, yuvTable[w7])) pattern |= 0x0020;
+	if (w5 != w8 && diffYUV(yuv5, yuvTable[w8])) pattern |= 0x0040;
+	if (w5 != w9 && diffYUV(yuv5, yuvTable[w9])) pattern |= 0x0080;
+	return pattern;
+#endif
+}
+
 #endif
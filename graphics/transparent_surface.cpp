@@ -37,6 +37,19 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/transform_tools.h"
 
+// Blend four pixels at once where the compiler guarantees a vector unit
+// (SSE2 is part of the x86-64 baseline, NEON of AArch64 and of ARM builds
+// using -mfpu=neon). The kernels assume the little endian channel order.
+#ifdef SCUMM_LITTLE_ENDIAN
+#if defined(__SSE2__)
+#define TS_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define TS_USE_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 namespace Graphics {
 
 static const int kBModShift = 0;//img->format.bShift;
@@ -57,6 +70,224 @@ static const int kGIndex = 1;
 static const int kRIndex = 0;
 #endif
 
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+
+enum BlendKernel {
+	kKernelAlpha,
+	kKernelAdditive,
+	kKernelSubtractive,
+	kKernelMultiply
+};
+
+/**
+ * Fills in the colour modulation factors used by the vector kernels for two
+ * pixels, in the order of the channels in memory.
+ *
+ * Apart from the alpha blend with colormod (keepFull), the scalar code
+ * shifts by 8 bits less for unmodulated channels, which is the same as
+ * using a factor of 256. The alpha channel gets a factor of 0, so that it
+ * stays untouched.
+ */
+static void getBlendFactors(uint32 color, bool keepFull, uint16 *factors) {
+	const byte channels[4] = { 0, (byte)(color >> kBModShift), (byte)(color >> kGModShift), (byte)(color >> kRModShift) };
+	for (int i = 0; i < 8; i++) {
+		const byte c = channels[i & 3];
+		factors[i] = (i & 3) && c == 255 && !keepFull ? 256 : c;
+	}
+}
+
+#endif
+
+#if defined(TS_USE_SSE2)
+
+struct BlendColor {
+	BlendColor(uint32 color, bool keepFull) {
+		uint16 factors[8];
+		getBlendFactors(color, keepFull, factors);
+		mul = _mm_loadu_si128((const __m128i *)factors);
+		alpha = _mm_set1_epi16((color >> kAModShift) & 0xFF);
+	}
+
+	__m128i mul;
+	__m128i alpha;
+};
+
+static FORCEINLINE __m128i loadPixels(const byte *in, int32 inStep) {
+	if (inStep > 0)
+		return _mm_loadu_si128((const __m128i *)in);
+	// Horizontally flipped blits read the source backwards
+	return _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(in - 12)), _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+/**
+ * Blends two pixels with 16 bits per channel. Every step is exact in 16 bits
+ * and matches the rounding of the corresponding scalar code.
+ */
+template<int kKernel, bool kColorMod>
+static FORCEINLINE __m128i blendHalf(__m128i s, __m128i d, const BlendColor &color) {
+	const __m128i c255 = _mm_set1_epi16(255);
+	__m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+	if (kColorMod && kKernel != kKernelSubtractive)
+		a = _mm_srli_epi16(_mm_mullo_epi16(a, color.alpha), 8);
+
+	switch (kKernel) {
+	case kKernelAlpha:
+		if (kColorMod)
+			return _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(d, _mm_sub_epi16(c255, a)), 8),
+			                     _mm_mulhi_epu16(_mm_mullo_epi16(s, color.mul), a));
+		return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(c255, a))), 8);
+	case kKernelAdditive:
+		return _mm_mulhi_epu16(_mm_mullo_epi16(s, color.mul), a);
+	case kKernelSubtractive:
+		return _mm_sub_epi16(d, _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(s, color.mul), _mm_mullo_epi16(d, a)), 8));
+	default:
+		return _mm_srli_epi16(_mm_mullo_epi16(d, _mm_mulhi_epu16(_mm_mullo_epi16(s, color.mul), a)), 8);
+	}
+}
+
+/**
+ * Blends as many pixels of a row as possible four at a time and returns the
+ * number of pixels done. The caller handles the rest.
+ */
+template<int kKernel, bool kColorMod>
+static uint32 blendRow(const byte *in, byte *out, uint32 width, int32 inStep, const BlendColor &color) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4, in += inStep * 4, out += 16) {
+		const __m128i src = loadPixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+		__m128i result = _mm_packus_epi16(
+			blendHalf<kKernel, kColorMod>(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), color),
+			blendHalf<kKernel, kColorMod>(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), color));
+
+		switch (kKernel) {
+		case kKernelAlpha:
+			result = _mm_or_si128(result, alphaMask);
+			break;
+		case kKernelAdditive:
+			result = _mm_adds_epu8(dst, result);
+			break;
+		case kKernelSubtractive:
+			if (kColorMod)
+				result = _mm_or_si128(result, alphaMask);
+			break;
+		default:
+			result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(dst, alphaMask));
+			break;
+		}
+
+		// Without colormod, these leave pixels under a transparent source alone
+		if (!kColorMod && (kKernel == kKernelAlpha || kKernel == kKernelMultiply)) {
+			const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), zero);
+			result = _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, result));
+		}
+
+		_mm_storeu_si128((__m128i *)out, result);
+	}
+
+	return j;
+}
+
+#elif defined(TS_USE_NEON)
+
+struct BlendColor {
+	BlendColor(uint32 color, bool keepFull) {
+		uint16 factors[8];
+		getBlendFactors(color, keepFull, factors);
+		mul = vld1q_u16(factors);
+		alpha = vdupq_n_u16((color >> kAModShift) & 0xFF);
+	}
+
+	uint16x8_t mul;
+	uint16x8_t alpha;
+};
+
+static FORCEINLINE uint8x16_t loadPixels(const byte *in, int32 inStep) {
+	if (inStep > 0)
+		return vld1q_u8(in);
+	// Horizontally flipped blits read the source backwards
+	const uint32x4_t pixels = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(in - 12)));
+	return vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(pixels), vget_low_u32(pixels)));
+}
+
+static FORCEINLINE uint16x8_t mulHigh(uint16x8_t a, uint16x8_t b) {
+	return vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(a), vget_low_u16(b)), 16),
+	                    vshrn_n_u32(vmull_u16(vget_high_u16(a), vget_high_u16(b)), 16));
+}
+
+/**
+ * Blends two pixels with 16 bits per channel. Every step is exact in 16 bits
+ * and matches the rounding of the corresponding scalar code.
+ */
+template<int kKernel, bool kColorMod>
+static FORCEINLINE uint16x8_t blendHalf(uint16x8_t s, uint16x8_t d, uint16x8_t a, const BlendColor &color) {
+	const uint16x8_t c255 = vdupq_n_u16(255);
+	if (kColorMod && kKernel != kKernelSubtractive)
+		a = vshrq_n_u16(vmulq_u16(a, color.alpha), 8);
+
+	switch (kKernel) {
+	case kKernelAlpha:
+		if (kColorMod)
+			return vaddq_u16(vshrq_n_u16(vmulq_u16(d, vsubq_u16(c255, a)), 8), mulHigh(vmulq_u16(s, color.mul), a));
+		return vshrq_n_u16(vmlaq_u16(vmulq_u16(s, a), d, vsubq_u16(c255, a)), 8);
+	case kKernelAdditive:
+		return mulHigh(vmulq_u16(s, color.mul), a);
+	case kKernelSubtractive:
+		return vsubq_u16(d, vshrq_n_u16(mulHigh(vmulq_u16(s, color.mul), vmulq_u16(d, a)), 8));
+	default:
+		return vshrq_n_u16(vmulq_u16(d, mulHigh(vmulq_u16(s, color.mul), a)), 8);
+	}
+}
+
+/**
+ * Blends as many pixels of a row as possible four at a time and returns the
+ * number of pixels done. The caller handles the rest.
+ */
+template<int kKernel, bool kColorMod>
+static uint32 blendRow(const byte *in, byte *out, uint32 width, int32 inStep, const BlendColor &color) {
+	const uint32x4_t alphaMask = vdupq_n_u32(0xFF);
+
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4, in += inStep * 4, out += 16) {
+		const uint8x16_t src = loadPixels(in, inStep);
+		const uint8x16_t dst = vld1q_u8(out);
+		const uint32x4_t srcAlpha = vandq_u32(vreinterpretq_u32_u8(src), alphaMask);
+		const uint8x16_t a = vreinterpretq_u8_u32(vmulq_n_u32(srcAlpha, 0x01010101));
+
+		uint8x16_t result = vcombine_u8(
+			vmovn_u16(blendHalf<kKernel, kColorMod>(vmovl_u8(vget_low_u8(src)), vmovl_u8(vget_low_u8(dst)), vmovl_u8(vget_low_u8(a)), color)),
+			vmovn_u16(blendHalf<kKernel, kColorMod>(vmovl_u8(vget_high_u8(src)), vmovl_u8(vget_high_u8(dst)), vmovl_u8(vget_high_u8(a)), color)));
+
+		switch (kKernel) {
+		case kKernelAlpha:
+			result = vorrq_u8(result, vreinterpretq_u8_u32(alphaMask));
+			break;
+		case kKernelAdditive:
+			result = vqaddq_u8(dst, result);
+			break;
+		case kKernelSubtractive:
+			if (kColorMod)
+				result = vorrq_u8(result, vreinterpretq_u8_u32(alphaMask));
+			break;
+		default:
+			result = vbslq_u8(vreinterpretq_u8_u32(alphaMask), dst, result);
+			break;
+		}
+
+		// Without colormod, these leave pixels under a transparent source alone
+		if (!kColorMod && (kKernel == kKernelAlpha || kKernel == kKernelMultiply))
+			result = vbslq_u8(vreinterpretq_u8_u32(vceqq_u32(srcAlpha, vdupq_n_u32(0))), dst, result);
+
+		vst1q_u8(out, result);
+	}
+
+	return j;
+}
+
+#endif
+
 void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
@@ -143,13 +374,22 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+	const BlendColor simdColor(color, true);
+#endif
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+			j = blendRow<kKernelAlpha, false>(in, out, width, inStep, simdColor);
+			in += (int32)j * inStep;
+			out += j * 4;
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kAIndex] = 255;
@@ -174,7 +414,13 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+			j = blendRow<kKernelAlpha, true>(in, out, width, inStep, simdColor);
+			in += (int32)j * inStep;
+			out += j * 4;
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 				out[kAIndex] = 255;
@@ -201,13 +447,22 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+	const BlendColor simdColor(color, false);
+#endif
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+			j = blendRow<kKernelAdditive, false>(in, out, width, inStep, simdColor);
+			in += (int32)j * inStep;
+			out += j * 4;
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) + out[kRIndex], 255);
@@ -231,7 +486,13 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+			j = blendRow<kKernelAdditive, true>(in, out, width, inStep, simdColor);
+			in += (int32)j * inStep;
+			out += j * 4;
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 
@@ -268,13 +529,22 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+	const BlendColor simdColor(color, false);
+#endif
 
 	if (color == 0xffffffff) {
 
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+			j = blendRow<kKernelSubtractive, false>(in, out, width, inStep, simdColor);
+			in += (int32)j * inStep;
+			out += j * 4;
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * out[kRIndex]) * in[kAIndex] >> 16), 0);
@@ -297,7 +567,13 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+			j = blendRow<kKernelSubtractive, true>(in, out, width, inStep, simdColor);
+			in += (int32)j * inStep;
+			out += j * 4;
+#endif
+			for (; j < width; j++) {
 
 				out[kAIndex] = 255;
 				if (cb != 255) {
@@ -333,12 +609,21 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
 	byte *in;
 	byte *out;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+	const BlendColor simdColor(color, false);
+#endif
 
 	if (color == 0xffffffff) {
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+			j = blendRow<kKernelMultiply, false>(in, out, width, inStep, simdColor);
+			in += (int32)j * inStep;
+			out += j * 4;
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) * out[kRIndex] >> 8, 255);
@@ -361,7 +646,13 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#if defined(TS_USE_SSE2) || defined(TS_USE_NEON)
+			j = blendRow<kKernelMultiply, true>(in, out, width, inStep, simdColor);
+			in += (int32)j * inStep;
+			out += j * 4;
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 
@@ -771,6 +1062,76 @@ systems.
 
 struct tColorRGBA { byte r; byte g; byte b; byte a; };
 
+/**
+ * Interpolates between the four source pixels around a sample point.
+ * @param ex horizontal position of the sample between the pixels, in 1/65536
+ * @param ey vertical position of the sample between the pixels, in 1/65536
+ */
+static FORCEINLINE void interpolateBilinear(tColorRGBA *dp, const tColorRGBA *c00, const tColorRGBA *c01, const tColorRGBA *c10, const tColorRGBA *c11, int ex, int ey) {
+#if defined(TS_USE_SSE2)
+	// Both rows are interpolated at once. The products are signed 16x16 bit
+	// multiplies, which see weights of 0x8000 and more as negative; adding
+	// the difference once more corrects for that without changing the
+	// rounding of the scalar code.
+	int32 p00, p01, p10, p11;
+	memcpy(&p00, c00, sizeof(p00));
+	memcpy(&p01, c01, sizeof(p01));
+	memcpy(&p10, c10, sizeof(p10));
+	memcpy(&p11, c11, sizeof(p11));
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i left = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(p00), _mm_cvtsi32_si128(p10)), zero);
+	const __m128i right = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(p01), _mm_cvtsi32_si128(p11)), zero);
+	const __m128i diffX = _mm_sub_epi16(right, left);
+	__m128i t = _mm_add_epi16(left, _mm_mulhi_epi16(diffX, _mm_set1_epi16((int16)ex)));
+	if (ex & 0x8000)
+		t = _mm_add_epi16(t, diffX);
+
+	const __m128i diffY = _mm_sub_epi16(_mm_unpackhi_epi64(t, t), t);
+	t = _mm_add_epi16(t, _mm_mulhi_epi16(diffY, _mm_set1_epi16((int16)ey)));
+	if (ey & 0x8000)
+		t = _mm_add_epi16(t, diffY);
+
+	const int32 pixel = _mm_cvtsi128_si32(_mm_packus_epi16(t, t));
+	memcpy(dp, &pixel, sizeof(pixel));
+#elif defined(TS_USE_NEON)
+	// Both rows are interpolated at once, with 32 bit products like the
+	// scalar code
+	byte leftPixels[8], rightPixels[8];
+	memcpy(leftPixels, c00, 4);
+	memcpy(leftPixels + 4, c10, 4);
+	memcpy(rightPixels, c01, 4);
+	memcpy(rightPixels + 4, c11, 4);
+	const int16x8_t left = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(leftPixels)));
+	const int16x8_t right = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(rightPixels)));
+	const int16x8_t diffX = vsubq_s16(right, left);
+	const int16x8_t t = vaddq_s16(left, vcombine_s16(
+		vshrn_n_s32(vmulq_n_s32(vmovl_s16(vget_low_s16(diffX)), ex), 16),
+		vshrn_n_s32(vmulq_n_s32(vmovl_s16(vget_high_s16(diffX)), ex), 16)));
+
+	const int16x4_t t1 = vget_low_s16(t);
+	const int16x4_t diffY = vsub_s16(vget_high_s16(t), t1);
+	const int16x4_t result = vadd_s16(t1, vshrn_n_s32(vmulq_n_s32(vmovl_s16(diffY), ey), 16));
+
+	const uint32 pixel = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vreinterpretq_u16_s16(vcombine_s16(result, result)))), 0);
+	memcpy(dp, &pixel, sizeof(pixel));
+#else
+	int t1, t2;
+	t1 = ((((c01->r - c00->r) * ex) >> 16) + c00->r) & 0xff;
+	t2 = ((((c11->r - c10->r) * ex) >> 16) + c10->r) & 0xff;
+	dp->r = (((t2 - t1) * ey) >> 16) + t1;
+	t1 = ((((c01->g - c00->g) * ex) >> 16) + c00->g) & 0xff;
+	t2 = ((((c11->g - c10->g) * ex) >> 16) + c10->g) & 0xff;
+	dp->g = (((t2 - t1) * ey) >> 16) + t1;
+	t1 = ((((c01->b - c00->b) * ex) >> 16) + c00->b) & 0xff;
+	t2 = ((((c11->b - c10->b) * ex) >> 16) + c10->b) & 0xff;
+	dp->b = (((t2 - t1) * ey) >> 16) + t1;
+	t1 = ((((c01->a - c00->a) * ex) >> 16) + c00->a) & 0xff;
+	t2 = ((((c11->a - c10->a) * ex) >> 16) + c10->a) & 0xff;
+	dp->a = (((t2 - t1) * ey) >> 16) + t1;
+#endif
+}
+
 template <TFilteringMode filteringMode>
 TransparentSurface *TransparentSurface::rotoscaleT(const TransformStruct &transform) const {
 
@@ -855,21 +1216,7 @@ TransparentSurface *TransparentSurface::rotoscaleT(const TransformStruct &transf
 					/*
 					* Interpolate colors
 					*/
-					int ex = (sdx & 0xffff);
-					int ey = (sdy & 0xffff);
-					int t1, t2;
-					t1 = ((((c01.r - c00.r) * ex) >> 16) + c00.r) & 0xff;
-					t2 = ((((c11.r - c10.r) * ex) >> 16) + c10.r) & 0xff;
-					pc->r = (((t2 - t1) * ey) >> 16) + t1;
-					t1 = ((((c01.g - c00.g) * ex) >> 16) + c00.g) & 0xff;
-					t2 = ((((c11.g - c10.g) * ex) >> 16) + c10.g) & 0xff;
-					pc->g = (((t2 - t1) * ey) >> 16) + t1;
-					t1 = ((((c01.b - c00.b) * ex) >> 16) + c00.b) & 0xff;
-					t2 = ((((c11.b - c10.b) * ex) >> 16) + c10.b) & 0xff;
-					pc->b = (((t2 - t1) * ey) >> 16) + t1;
-					t1 = ((((c01.a - c00.a) * ex) >> 16) + c00.a) & 0xff;
-					t2 = ((((c11.a - c10.a) * ex) >> 16) + c10.a) & 0xff;
-					pc->a = (((t2 - t1) * ey) >> 16) + t1;
+					interpolateBilinear(pc, &c00, &c01, &c10, &c11, sdx & 0xffff, sdy & 0xffff);
 				}
 			} else {
 				if ((dx >= 0) && (dy >= 0) && (dx < srcW) && (dy < srcH)) {
@@ -996,19 +1343,7 @@ TransparentSurface *TransparentSurface::scaleT(uint16 newWidth, uint16 newHeight
 				/*
 				* Draw and interpolate colors
 				*/
-				int t1, t2;
-				t1 = ((((c01->r - c00->r) * ex) >> 16) + c00->r) & 0xff;
-				t2 = ((((c11->r - c10->r) * ex) >> 16) + c10->r) & 0xff;
-				dp->r = (((t2 - t1) * ey) >> 16) + t1;
-				t1 = ((((c01->g - c00->g) * ex) >> 16) + c00->g) & 0xff;
-				t2 = ((((c11->g - c10->g) * ex) >> 16) + c10->g) & 0xff;
-				dp->g = (((t2 - t1) * ey) >> 16) + t1;
-				t1 = ((((c01->b - c00->b) * ex) >> 16) + c00->b) & 0xff;
-				t2 = ((((c11->b - c10->b) * ex) >> 16) + c10->b) & 0xff;
-				dp->b = (((t2 - t1) * ey) >> 16) + t1;
-				t1 = ((((c01->a - c00->a) * ex) >> 16) + c00->a) & 0xff;
-				t2 = ((((c11->a - c10->a) * ex) >> 16) + c10->a) & 0xff;
-				dp->a = (((t2 - t1) * ey) >> 16) + t1;
+				interpolateBilinear(dp, c00, c01, c10, c11, ex, ey);
 
 				/*
 				* Advance source pointer x
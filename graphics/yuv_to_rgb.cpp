@@ -86,6 +86,17 @@
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
+// Use the vector unit for the conversion where the compiler guarantees it is
+// present (SSE2 is part of the x86-64 baseline, NEON of AArch64 and of ARM
+// builds using -mfpu=neon).
+#if defined(__SSE2__)
+#define YUV_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define YUV_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 }
@@ -192,6 +203,427 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+
+// The vector code below computes the same values as the lookup tables: the
+// chroma terms are the Cr_r/Cr_g/Cb_g/Cb_b tables (without their offsets into
+// the RGB lookup table), evaluated as |c| * k with a 16-bit fixed point k
+// which truncates exactly like the conversion from double does for all
+// |c| <= 128, and the channels are clamped (and for kScaleITU stretched) the
+// way the RGB lookup table is filled.
+enum {
+	kCrRMul = 45920, // 0.419 / 0.299, applied to |Cr| * 2
+	kCrGMul = 46766, // 0.299 / 0.419
+	kCbGMul = 22571, // 0.114 / 0.331
+	kCbBMul = 58111, // 0.587 / 0.331, applied to |Cb| * 2
+	kITUMul = 38155  // 255 / 219, applied to (v - 16) * 2
+};
+
+#if defined(YUV_USE_SSE2)
+
+/**
+ * The shifts and masks needed to assemble pixels of the destination format.
+ */
+struct YUVToRGBPacker {
+	YUVToRGBPacker(const YUVToRGBLookup *lookup) {
+		const Graphics::PixelFormat format = lookup->getFormat();
+		fullScale = (lookup->getScale() == YUVToRGBManager::kScaleFull);
+		lossR = _mm_cvtsi32_si128(format.rLoss);
+		lossG = _mm_cvtsi32_si128(format.gLoss);
+		lossB = _mm_cvtsi32_si128(format.bLoss);
+		shiftR = _mm_cvtsi32_si128(format.rShift);
+		shiftG = _mm_cvtsi32_si128(format.gShift);
+		shiftB = _mm_cvtsi32_si128(format.bShift);
+		alpha = (0xFF >> format.aLoss) << format.aShift;
+
+		packHalves = setHalfShifts(format.rShift, format.rLoss, lowR, highR);
+		packHalves &= setHalfShifts(format.gShift, format.gLoss, lowG, highG);
+		packHalves &= setHalfShifts(format.bShift, format.bLoss, lowB, highB);
+	}
+
+	/**
+	 * Set up the shifts which place a channel in the low and the high 16
+	 * bits of a 32-bit pixel. Shifting a 16-bit lane by 16 clears it.
+	 *
+	 * @return false if the channel straddles both halves
+	 */
+	static bool setHalfShifts(int shift, int loss, __m128i &low, __m128i &high) {
+		low = _mm_cvtsi32_si128(shift < 16 ? shift : 16);
+		high = _mm_cvtsi32_si128(shift >= 16 ? shift - 16 : 16);
+		return shift >= 16 || shift + 8 - loss <= 16;
+	}
+
+	bool fullScale;
+	__m128i lossR, lossG, lossB;
+	__m128i shiftR, shiftG, shiftB;
+	uint32 alpha;
+
+	/** Whether 32-bit pixels can be assembled from two 16-bit halves. */
+	bool packHalves;
+	__m128i lowR, lowG, lowB;
+	__m128i highR, highG, highB;
+};
+
+/**
+ * Calculate the chroma terms of eight 16-bit U and V values.
+ */
+static FORCEINLINE void calcChroma(__m128i u, __m128i v, __m128i &r, __m128i &g, __m128i &b) {
+	const __m128i bias = _mm_set1_epi16(128);
+	const __m128i cr = _mm_sub_epi16(v, bias);
+	const __m128i cb = _mm_sub_epi16(u, bias);
+	const __m128i crSign = _mm_srai_epi16(cr, 15);
+	const __m128i cbSign = _mm_srai_epi16(cb, 15);
+	const __m128i crAbs = _mm_sub_epi16(_mm_xor_si128(cr, crSign), crSign);
+	const __m128i cbAbs = _mm_sub_epi16(_mm_xor_si128(cb, cbSign), cbSign);
+
+	const __m128i crR = _mm_mulhi_epu16(_mm_add_epi16(crAbs, crAbs), _mm_set1_epi16((int16)kCrRMul));
+	const __m128i crG = _mm_mulhi_epu16(crAbs, _mm_set1_epi16((int16)kCrGMul));
+	const __m128i cbG = _mm_mulhi_epu16(cbAbs, _mm_set1_epi16((int16)kCbGMul));
+	const __m128i cbB = _mm_mulhi_epu16(_mm_add_epi16(cbAbs, cbAbs), _mm_set1_epi16((int16)kCbBMul));
+
+	r = _mm_sub_epi16(_mm_xor_si128(crR, crSign), crSign);
+	b = _mm_sub_epi16(_mm_xor_si128(cbB, cbSign), cbSign);
+	// The green terms are negative
+	g = _mm_sub_epi16(_mm_sub_epi16(_mm_setzero_si128(), _mm_sub_epi16(_mm_xor_si128(crG, crSign), crSign)),
+	                  _mm_sub_epi16(_mm_xor_si128(cbG, cbSign), cbSign));
+}
+
+static FORCEINLINE __m128i scaleChannel(__m128i v, bool fullScale) {
+	if (fullScale)
+		return _mm_min_epi16(_mm_max_epi16(v, _mm_setzero_si128()), _mm_set1_epi16(255));
+
+	const __m128i min = _mm_set1_epi16(16);
+	v = _mm_sub_epi16(_mm_min_epi16(_mm_max_epi16(v, min), _mm_set1_epi16(235)), min);
+	return _mm_mulhi_epu16(_mm_add_epi16(v, v), _mm_set1_epi16((int16)kITUMul));
+}
+
+/**
+ * Convert eight pixels, given their luminance and chroma terms.
+ */
+template<typename PixelInt>
+static FORCEINLINE void putPixels(PixelInt *dst, const byte *ySrc, __m128i r, __m128i g, __m128i b, const YUVToRGBPacker &packer) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)ySrc), zero);
+
+	r = _mm_srl_epi16(scaleChannel(_mm_add_epi16(y, r), packer.fullScale), packer.lossR);
+	g = _mm_srl_epi16(scaleChannel(_mm_add_epi16(y, g), packer.fullScale), packer.lossG);
+	b = _mm_srl_epi16(scaleChannel(_mm_add_epi16(y, b), packer.fullScale), packer.lossB);
+
+	if (sizeof(PixelInt) == 2) {
+		__m128i pixels = _mm_or_si128(_mm_sll_epi16(r, packer.shiftR), _mm_sll_epi16(g, packer.shiftG));
+		pixels = _mm_or_si128(pixels, _mm_sll_epi16(b, packer.shiftB));
+		pixels = _mm_or_si128(pixels, _mm_set1_epi16((int16)packer.alpha));
+		_mm_storeu_si128((__m128i *)dst, pixels);
+	} else if (packer.packHalves) {
+		__m128i low = _mm_or_si128(_mm_sll_epi16(r, packer.lowR), _mm_sll_epi16(g, packer.lowG));
+		__m128i high = _mm_or_si128(_mm_sll_epi16(r, packer.highR), _mm_sll_epi16(g, packer.highG));
+		low = _mm_or_si128(low, _mm_or_si128(_mm_sll_epi16(b, packer.lowB), _mm_set1_epi16((int16)(packer.alpha & 0xFFFF))));
+		high = _mm_or_si128(high, _mm_or_si128(_mm_sll_epi16(b, packer.highB), _mm_set1_epi16((int16)(packer.alpha >> 16))));
+		_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(low, high));
+		_mm_storeu_si128((__m128i *)(dst + 4), _mm_unpackhi_epi16(low, high));
+	} else {
+		const __m128i alpha = _mm_set1_epi32(packer.alpha);
+		__m128i lo = _mm_or_si128(alpha, _mm_sll_epi32(_mm_unpacklo_epi16(r, zero), packer.shiftR));
+		__m128i hi = _mm_or_si128(alpha, _mm_sll_epi32(_mm_unpackhi_epi16(r, zero), packer.shiftR));
+		lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), packer.shiftG));
+		hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), packer.shiftG));
+		lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), packer.shiftB));
+		hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), packer.shiftB));
+		_mm_storeu_si128((__m128i *)dst, lo);
+		_mm_storeu_si128((__m128i *)(dst + 4), hi);
+	}
+}
+
+/**
+ * Convert eight pixels with their own chroma values.
+ */
+template<typename PixelInt>
+static inline void convert444Block(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const YUVToRGBPacker &packer) {
+	const __m128i zero = _mm_setzero_si128();
+	__m128i r, g, b;
+	calcChroma(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)uSrc), zero),
+	           _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)vSrc), zero), r, g, b);
+	putPixels<PixelInt>(dst, ySrc, r, g, b, packer);
+}
+
+/**
+ * Convert 2x16 pixels sharing eight chroma values.
+ */
+template<typename PixelInt>
+static inline void convert420Block(PixelInt *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, const YUVToRGBPacker &packer) {
+	const __m128i zero = _mm_setzero_si128();
+	__m128i r, g, b;
+	calcChroma(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)uSrc), zero),
+	           _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)vSrc), zero), r, g, b);
+
+	const __m128i r0 = _mm_unpacklo_epi16(r, r), r1 = _mm_unpackhi_epi16(r, r);
+	const __m128i g0 = _mm_unpacklo_epi16(g, g), g1 = _mm_unpackhi_epi16(g, g);
+	const __m128i b0 = _mm_unpacklo_epi16(b, b), b1 = _mm_unpackhi_epi16(b, b);
+
+	PixelInt *dst2 = (PixelInt *)((byte *)dst + dstPitch);
+	putPixels<PixelInt>(dst, ySrc, r0, g0, b0, packer);
+	putPixels<PixelInt>(dst + 8, ySrc + 8, r1, g1, b1, packer);
+	putPixels<PixelInt>(dst2, ySrc + yPitch, r0, g0, b0, packer);
+	putPixels<PixelInt>(dst2 + 8, ySrc + yPitch + 8, r1, g1, b1, packer);
+}
+
+/**
+ * Convert 32 pixels, interpolating the chroma between nine columns of two
+ * chroma rows.
+ */
+template<typename PixelInt>
+static inline void convert410Block(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int uvPitch, int yDiff, const YUVToRGBPacker &packer) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i top = _mm_set1_epi16(4 - yDiff);
+	const __m128i bottom = _mm_set1_epi16(yDiff);
+
+	// Interpolate vertically first, A * (4 - x) * (4 - y) + B * x * (4 - y) +
+	// C * y * (4 - x) + D * x * y is the same as (4 - x) * (A * (4 - y) + C * y) +
+	// x * (B * (4 - y) + D * y).
+#define YUV410_COLUMNS(src, left, right) \
+	const __m128i left = _mm_add_epi16( \
+		_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src)), zero), top), \
+		_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)((src) + uvPitch)), zero), bottom)); \
+	const __m128i right = _mm_add_epi16( \
+		_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)((src) + 1)), zero), top), \
+		_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)((src) + uvPitch + 1)), zero), bottom))
+
+	YUV410_COLUMNS(uSrc, uLeft, uRight);
+	YUV410_COLUMNS(vSrc, vLeft, vRight);
+#undef YUV410_COLUMNS
+
+	// Then horizontally, and interleave the four results of each column
+	__m128i u[4], v[4];
+	for (int xDiff = 0; xDiff < 4; xDiff++) {
+		const __m128i left = _mm_set1_epi16(4 - xDiff);
+		const __m128i right = _mm_set1_epi16(xDiff);
+		u[xDiff] = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(uLeft, left), _mm_mullo_epi16(uRight, right)), 4);
+		v[xDiff] = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(vLeft, left), _mm_mullo_epi16(vRight, right)), 4);
+	}
+
+	const __m128i u01lo = _mm_unpacklo_epi16(u[0], u[1]), u01hi = _mm_unpackhi_epi16(u[0], u[1]);
+	const __m128i u23lo = _mm_unpacklo_epi16(u[2], u[3]), u23hi = _mm_unpackhi_epi16(u[2], u[3]);
+	const __m128i v01lo = _mm_unpacklo_epi16(v[0], v[1]), v01hi = _mm_unpackhi_epi16(v[0], v[1]);
+	const __m128i v23lo = _mm_unpacklo_epi16(v[2], v[3]), v23hi = _mm_unpackhi_epi16(v[2], v[3]);
+
+	const __m128i uPixels[4] = {
+		_mm_unpacklo_epi32(u01lo, u23lo), _mm_unpackhi_epi32(u01lo, u23lo),
+		_mm_unpacklo_epi32(u01hi, u23hi), _mm_unpackhi_epi32(u01hi, u23hi)
+	};
+	const __m128i vPixels[4] = {
+		_mm_unpacklo_epi32(v01lo, v23lo), _mm_unpackhi_epi32(v01lo, v23lo),
+		_mm_unpacklo_epi32(v01hi, v23hi), _mm_unpackhi_epi32(v01hi, v23hi)
+	};
+
+	for (int i = 0; i < 4; i++) {
+		__m128i r, g, b;
+		calcChroma(uPixels[i], vPixels[i], r, g, b);
+		putPixels<PixelInt>(dst + i * 8, ySrc + i * 8, r, g, b, packer);
+	}
+}
+
+#elif defined(YUV_USE_NEON)
+
+/**
+ * The shifts and masks needed to assemble pixels of the destination format.
+ */
+struct YUVToRGBPacker {
+	YUVToRGBPacker(const YUVToRGBLookup *lookup) {
+		const Graphics::PixelFormat format = lookup->getFormat();
+		fullScale = (lookup->getScale() == YUVToRGBManager::kScaleFull);
+		// NEON shifts right by shifting left by a negative amount
+		lossR = vdupq_n_s16(-format.rLoss);
+		lossG = vdupq_n_s16(-format.gLoss);
+		lossB = vdupq_n_s16(-format.bLoss);
+		shiftR = format.rShift;
+		shiftG = format.gShift;
+		shiftB = format.bShift;
+		alpha = (0xFF >> format.aLoss) << format.aShift;
+
+		packHalves = setHalfShifts(format.rShift, format.rLoss, lowR, highR);
+		packHalves &= setHalfShifts(format.gShift, format.gLoss, lowG, highG);
+		packHalves &= setHalfShifts(format.bShift, format.bLoss, lowB, highB);
+#ifdef SCUMM_BIG_ENDIAN
+		// The interleaving store puts the low half first
+		packHalves = false;
+#endif
+	}
+
+	/**
+	 * Set up the shifts which place a channel in the low and the high 16
+	 * bits of a 32-bit pixel. Shifting a 16-bit lane by 16 clears it.
+	 *
+	 * @return false if the channel straddles both halves
+	 */
+	static bool setHalfShifts(int shift, int loss, int16x8_t &low, int16x8_t &high) {
+		low = vdupq_n_s16(shift < 16 ? shift : 16);
+		high = vdupq_n_s16(shift >= 16 ? shift - 16 : 16);
+		return shift >= 16 || shift + 8 - loss <= 16;
+	}
+
+	bool fullScale;
+	int16x8_t lossR, lossG, lossB;
+	int shiftR, shiftG, shiftB;
+	uint32 alpha;
+
+	/** Whether 32-bit pixels can be assembled from two 16-bit halves. */
+	bool packHalves;
+	int16x8_t lowR, lowG, lowB;
+	int16x8_t highR, highG, highB;
+};
+
+/**
+ * Return the high 16 bits of the unsigned products, like _mm_mulhi_epu16.
+ */
+static FORCEINLINE int16x8_t mulHigh(int16x8_t c, uint16 mul) {
+	const uint16x8_t a = vreinterpretq_u16_s16(c);
+	const uint16x4_t m = vdup_n_u16(mul);
+	return vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(a), m), 16),
+	                                          vshrn_n_u32(vmull_u16(vget_high_u16(a), m), 16)));
+}
+
+/**
+ * Calculate the chroma terms of eight 16-bit U and V values.
+ */
+static FORCEINLINE void calcChroma(int16x8_t u, int16x8_t v, int16x8_t &r, int16x8_t &g, int16x8_t &b) {
+	const int16x8_t bias = vdupq_n_s16(128);
+	const int16x8_t cr = vsubq_s16(v, bias);
+	const int16x8_t cb = vsubq_s16(u, bias);
+	const int16x8_t crAbs = vabsq_s16(cr);
+	const int16x8_t cbAbs = vabsq_s16(cb);
+	// All ones for negative values
+	const uint16x8_t crNeg = vcltq_s16(cr, vdupq_n_s16(0));
+	const uint16x8_t cbNeg = vcltq_s16(cb, vdupq_n_s16(0));
+
+	const int16x8_t crR = mulHigh(vaddq_s16(crAbs, crAbs), kCrRMul);
+	const int16x8_t crG = mulHigh(crAbs, kCrGMul);
+	const int16x8_t cbG = mulHigh(cbAbs, kCbGMul);
+	const int16x8_t cbB = mulHigh(vaddq_s16(cbAbs, cbAbs), kCbBMul);
+
+	r = vbslq_s16(crNeg, vnegq_s16(crR), crR);
+	b = vbslq_s16(cbNeg, vnegq_s16(cbB), cbB);
+	// The green terms are negative
+	g = vaddq_s16(vbslq_s16(crNeg, crG, vnegq_s16(crG)), vbslq_s16(cbNeg, cbG, vnegq_s16(cbG)));
+}
+
+static FORCEINLINE uint16x8_t scaleChannel(int16x8_t v, bool fullScale) {
+	if (fullScale)
+		return vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(v, vdupq_n_s16(0)), vdupq_n_s16(255)));
+
+	const int16x8_t min = vdupq_n_s16(16);
+	const int16x8_t x = vsubq_s16(vminq_s16(vmaxq_s16(v, min), vdupq_n_s16(235)), min);
+	return vreinterpretq_u16_s16(mulHigh(vaddq_s16(x, x), kITUMul));
+}
+
+/**
+ * Convert eight pixels, given their luminance and chroma terms.
+ */
+template<typename PixelInt>
+static FORCEINLINE void putPixels(PixelInt *dst, const byte *ySrc, int16x8_t r, int16x8_t g, int16x8_t b, const YUVToRGBPacker &packer) {
+	const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(ySrc)));
+
+	const uint16x8_t ur = vshlq_u16(scaleChannel(vaddq_s16(y, r), packer.fullScale), packer.lossR);
+	const uint16x8_t ug = vshlq_u16(scaleChannel(vaddq_s16(y, g), packer.fullScale), packer.lossG);
+	const uint16x8_t ub = vshlq_u16(scaleChannel(vaddq_s16(y, b), packer.fullScale), packer.lossB);
+
+	if (sizeof(PixelInt) == 2) {
+		uint16x8_t pixels = vorrq_u16(vshlq_u16(ur, vdupq_n_s16(packer.shiftR)), vshlq_u16(ug, vdupq_n_s16(packer.shiftG)));
+		pixels = vorrq_u16(pixels, vshlq_u16(ub, vdupq_n_s16(packer.shiftB)));
+		pixels = vorrq_u16(pixels, vdupq_n_u16((uint16)packer.alpha));
+		vst1q_u16((uint16 *)dst, pixels);
+	} else if (packer.packHalves) {
+		uint16x8x2_t halves;
+		halves.val[0] = vorrq_u16(vshlq_u16(ur, packer.lowR), vshlq_u16(ug, packer.lowG));
+		halves.val[1] = vorrq_u16(vshlq_u16(ur, packer.highR), vshlq_u16(ug, packer.highG));
+		halves.val[0] = vorrq_u16(halves.val[0], vorrq_u16(vshlq_u16(ub, packer.lowB), vdupq_n_u16((uint16)(packer.alpha & 0xFFFF))));
+		halves.val[1] = vorrq_u16(halves.val[1], vorrq_u16(vshlq_u16(ub, packer.highB), vdupq_n_u16((uint16)(packer.alpha >> 16))));
+		// Interleaving stores the low and high halves of each pixel
+		vst2q_u16((uint16 *)dst, halves);
+	} else {
+		const uint32x4_t alpha = vdupq_n_u32(packer.alpha);
+		const int32x4_t shiftR = vdupq_n_s32(packer.shiftR);
+		const int32x4_t shiftG = vdupq_n_s32(packer.shiftG);
+		const int32x4_t shiftB = vdupq_n_s32(packer.shiftB);
+		uint32x4_t lo = vorrq_u32(alpha, vshlq_u32(vmovl_u16(vget_low_u16(ur)), shiftR));
+		uint32x4_t hi = vorrq_u32(alpha, vshlq_u32(vmovl_u16(vget_high_u16(ur)), shiftR));
+		lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(vget_low_u16(ug)), shiftG));
+		hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(vget_high_u16(ug)), shiftG));
+		lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(vget_low_u16(ub)), shiftB));
+		hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(vget_high_u16(ub)), shiftB));
+		vst1q_u32((uint32 *)dst, lo);
+		vst1q_u32((uint32 *)dst + 4, hi);
+	}
+}
+
+static FORCEINLINE int16x8_t loadChroma(const byte *src) {
+	return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src)));
+}
+
+/**
+ * Convert eight pixels with their own chroma values.
+ */
+template<typename PixelInt>
+static inline void convert444Block(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, const YUVToRGBPacker &packer) {
+	int16x8_t r, g, b;
+	calcChroma(loadChroma(uSrc), loadChroma(vSrc), r, g, b);
+	putPixels<PixelInt>(dst, ySrc, r, g, b, packer);
+}
+
+/**
+ * Convert 2x16 pixels sharing eight chroma values.
+ */
+template<typename PixelInt>
+static inline void convert420Block(PixelInt *dst, int dstPitch, const byte *ySrc, int yPitch, const byte *uSrc, const byte *vSrc, const YUVToRGBPacker &packer) {
+	int16x8_t r, g, b;
+	calcChroma(loadChroma(uSrc), loadChroma(vSrc), r, g, b);
+
+	const int16x8x2_t rr = vzipq_s16(r, r);
+	const int16x8x2_t gg = vzipq_s16(g, g);
+	const int16x8x2_t bb = vzipq_s16(b, b);
+
+	PixelInt *dst2 = (PixelInt *)((byte *)dst + dstPitch);
+	putPixels<PixelInt>(dst, ySrc, rr.val[0], gg.val[0], bb.val[0], packer);
+	putPixels<PixelInt>(dst + 8, ySrc + 8, rr.val[1], gg.val[1], bb.val[1], packer);
+	putPixels<PixelInt>(dst2, ySrc + yPitch, rr.val[0], gg.val[0], bb.val[0], packer);
+	putPixels<PixelInt>(dst2 + 8, ySrc + yPitch + 8, rr.val[1], gg.val[1], bb.val[1], packer);
+}
+
+/**
+ * Convert 32 pixels, interpolating the chroma between nine columns of two
+ * chroma rows.
+ */
+template<typename PixelInt>
+static inline void convert410Block(PixelInt *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int uvPitch, int yDiff, const YUVToRGBPacker &packer) {
+	const int16 top = 4 - yDiff;
+
+	// Interpolate vertically first, see the SSE2 version
+	const int16x8_t uLeft = vaddq_s16(vmulq_n_s16(loadChroma(uSrc), top), vmulq_n_s16(loadChroma(uSrc + uvPitch), yDiff));
+	const int16x8_t uRight = vaddq_s16(vmulq_n_s16(loadChroma(uSrc + 1), top), vmulq_n_s16(loadChroma(uSrc + uvPitch + 1), yDiff));
+	const int16x8_t vLeft = vaddq_s16(vmulq_n_s16(loadChroma(vSrc), top), vmulq_n_s16(loadChroma(vSrc + uvPitch), yDiff));
+	const int16x8_t vRight = vaddq_s16(vmulq_n_s16(loadChroma(vSrc + 1), top), vmulq_n_s16(loadChroma(vSrc + uvPitch + 1), yDiff));
+
+	// Then horizontally, and interleave the four results of each column
+	int16x8x4_t u, v;
+	for (int xDiff = 0; xDiff < 4; xDiff++) {
+		u.val[xDiff] = vshrq_n_s16(vaddq_s16(vmulq_n_s16(uLeft, 4 - xDiff), vmulq_n_s16(uRight, xDiff)), 4);
+		v.val[xDiff] = vshrq_n_s16(vaddq_s16(vmulq_n_s16(vLeft, 4 - xDiff), vmulq_n_s16(vRight, xDiff)), 4);
+	}
+
+	int16 uPixels[32], vPixels[32];
+	vst4q_s16(uPixels, u);
+	vst4q_s16(vPixels, v);
+
+	for (int i = 0; i < 4; i++) {
+		int16x8_t r, g, b;
+		calcChroma(vld1q_s16(uPixels + i * 8), vld1q_s16(vPixels + i * 8), r, g, b);
+		putPixels<PixelInt>(dst + i * 8, ySrc + i * 8, r, g, b, packer);
+	}
+}
+
+#endif
+
+#endif
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
@@ -205,8 +637,24 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+	const YUVToRGBPacker packer(lookup);
+#endif
+
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
+		int w = 0;
+
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+		for (; w + 8 <= yWidth; w += 8) {
+			convert444Block<PixelInt>((PixelInt *)dstPtr, ySrc, uSrc, vSrc, packer);
+			ySrc += 8;
+			uSrc += 8;
+			vSrc += 8;
+			dstPtr += 8 * sizeof(PixelInt);
+		}
+#endif
+
+		for (; w < yWidth; w++) {
 			register const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -254,8 +702,24 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const int16 *Cb_b_tab = Cb_g_tab + 256;
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+	const YUVToRGBPacker packer(lookup);
+#endif
+
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int w = 0;
+
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+		for (; w + 8 <= halfWidth; w += 8) {
+			convert420Block<PixelInt>((PixelInt *)dstPtr, dstPitch, ySrc, yPitch, uSrc, vSrc, packer);
+			ySrc += 16;
+			uSrc += 8;
+			vSrc += 8;
+			dstPtr += 16 * sizeof(PixelInt);
+		}
+#endif
+
+		for (; w < halfWidth; w++) {
 			register const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -333,8 +797,23 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 
 	int quarterWidth = yWidth >> 2;
 
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+	const YUVToRGBPacker packer(lookup);
+#endif
+
 	for (int y = 0; y < yHeight; y++) {
-		for (int x = 0; x < quarterWidth; x++) {
+		int x = 0;
+
+#if defined(YUV_USE_SSE2) || defined(YUV_USE_NEON)
+		for (; x + 8 <= quarterWidth; x += 8) {
+			int index = (y >> 2) * uvPitch + x;
+			convert410Block<PixelInt>((PixelInt *)dstPtr, ySrc, uSrc + index, vSrc + index, uvPitch, y & 3, packer);
+			ySrc += 32;
+			dstPtr += 32 * sizeof(PixelInt);
+		}
+#endif
+
+		for (; x < quarterWidth; x++) {
 			// Perform bilinear interpolation on the the chroma values
 			// Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
 			// Feel free to optimize further
@@ -88,6 +88,13 @@ EventRecorder::EventRecorder() {
 	_lastScreenshotTime = 0;
 	_screenshotPeriod = 0;
 	_playbackFile = 0;
+	_benchmark = false;
+	_benchmarkDisabledDisplay = false;
+	_benchmarkFrames = 0;
+	_benchmarkStart = 0;
+	_benchmarkFrameStart = 0;
+	_benchmarkEngineTime = 0;
+	_benchmarkMaxFrameTime = 0;
 
 	DebugMan.addDebugChannel(kDebugLevelEventRec, "EventRec", "Event recorder debug level");
 }
@@ -103,6 +110,15 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	const bool benchmarkFailed = _benchmark && _playbackFile->getFailedScreenshotsCount() != 0;
+	if (_benchmark) {
+		printBenchmarkSummary();
+		_benchmark = false;
+	}
+	if (_benchmarkDisabledDisplay) {
+		ConfMan.removeKey("disable_display", Common::ConfigManager::kTransientDomain);
+		_benchmarkDisabledDisplay = false;
+	}
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -118,6 +134,9 @@ void EventRecorder::deinit() {
 	switchMixer();
 	switchTimerManagers();
 	DebugMan.disableDebugChannel("EventRec");
+	if (benchmarkFailed) {
+		error("playback:action=error reason=\"screenshot mismatch\"");
+	}
 }
 
 void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
@@ -261,7 +280,7 @@ Common::String EventRecorder::generateRecordFileName(const Common::String &targe
 }
 
 
-void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
+void EventRecorder::init(Common::String recordFileName, RecordMode mode, bool benchmark) {
 	_fakeMixerManager = new NullSdlMixerManager();
 	_fakeMixerManager->init();
 	_fakeMixerManager->suspendAudio();
@@ -271,7 +290,8 @@ void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
 	_lastScreenshotTime = 0;
 	_recordMode = mode;
 	_needcontinueGame = false;
-	if (ConfMan.hasKey("disable_display")) {
+	_benchmark = benchmark && (mode == kRecorderPlayback);
+	if (ConfMan.hasKey("disable_display") || _benchmark) {
 		DebugMan.enableDebugChannel("EventRec");
 		gDebugLevel = 1;
 	}
@@ -295,6 +315,17 @@ void EventRecorder::init(Common::String recordFileName, RecordMode mode) {
 		applyPlaybackSettings();
 		_nextEvent = _playbackFile->getNextEvent();
 	}
+	if (_benchmark) {
+		// Nothing is shown and the recorded timer drives the game, so there
+		// is no reason to wait for anything
+		_benchmarkDisabledDisplay = !ConfMan.hasKey("disable_display", Common::ConfigManager::kTransientDomain);
+		ConfMan.setBool("disable_display", true, Common::ConfigManager::kTransientDomain);
+		_fastPlayback = true;
+		_benchmarkFrames = 0;
+		_benchmarkEngineTime = 0;
+		_benchmarkMaxFrameTime = 0;
+		_benchmarkStart = _benchmarkFrameStart = g_system->getMicros();
+	}
 	if (_recordMode == kRecorderRecord) {
 		getConfig();
 	}
@@ -557,6 +588,10 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark && _initialized) {
+		benchmarkFrame();
+		return;
+	}
     if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -571,6 +606,11 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark && _initialized) {
+		// The time spent by the backend on the screen update is not counted
+		_benchmarkFrameStart = g_system->getMicros();
+		return;
+	}
     if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -579,6 +619,23 @@ void EventRecorder::postDrawOverlayGui() {
 	}
 }
 
+void EventRecorder::benchmarkFrame() {
+	const uint32 frameTime = (uint32)(g_system->getMicros() - _benchmarkFrameStart);
+	_benchmarkFrames++;
+	_benchmarkEngineTime += frameTime;
+	_benchmarkMaxFrameTime = MAX<uint64>(_benchmarkMaxFrameTime, frameTime);
+	debugC(2, kDebugLevelEventRec, "playback:action=frame number=%u time=%u engine=%u", _benchmarkFrames, _fakeTimer, frameTime);
+}
+
+void EventRecorder::printBenchmarkSummary() {
+	const uint32 realTime = (uint32)((g_system->getMicros() - _benchmarkStart) / 1000);
+	const uint32 engineTime = (uint32)(_benchmarkEngineTime / 1000);
+	const uint32 averageFrameTime = _benchmarkFrames ? (uint32)(_benchmarkEngineTime / _benchmarkFrames) : 0;
+	debugC(1, kDebugLevelEventRec, "playback:action=benchmark frames=%u time=%u real=%u engine=%u average=%u max=%u screenshots=%u failed=%u",
+	       _benchmarkFrames, _fakeTimer, realTime, engineTime, averageFrameTime, (uint32)_benchmarkMaxFrameTime,
+	       _playbackFile->getCheckedScreenshotsCount(), _playbackFile->getFailedScreenshotsCount());
+}
+
 Common::StringArray EventRecorder::listSaveFiles(const Common::String &pattern) {
 	if (_recordMode == kRecorderPlayback) {
 		Common::StringArray result;
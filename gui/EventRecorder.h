@@ -78,7 +78,13 @@ public:
 		kRecorderPlaybackPause = 3	/**< kRecordetPlaybackPause, interal state when user pauses the playback */
 	};
 
-	void init(Common::String recordFileName, RecordMode mode);
+	/**
+	 * Start recording or playing back.
+	 *
+	 * @param benchmark play back without display and without delays, and
+	 *                  report the time the engine spent on each frame
+	 */
+	void init(Common::String recordFileName, RecordMode mode, bool benchmark = false);
 	void deinit();
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
@@ -229,6 +235,18 @@ private:
 	Common::String _recordFileName;
 	bool _fastPlayback;
 	bool _needRedraw;
+
+	bool _benchmark;
+	/** Whether the benchmark mode set disable_display, which deinit() has to undo. */
+	bool _benchmarkDisabledDisplay;
+	uint32 _benchmarkFrames;
+	uint64 _benchmarkStart;
+	uint64 _benchmarkFrameStart;
+	uint64 _benchmarkEngineTime;
+	uint64 _benchmarkMaxFrameTime;
+
+	void benchmarkFrame();
+	void printBenchmarkSummary();
 };
 
 } // End of namespace GUI
@@ -708,6 +708,15 @@ enum {
 	kNewSaveCmd = 'SAVE'
 };
 
+enum {
+	/**
+	 * Time (in ms) which may be spent on loading save meta infos per tickle.
+	 * Decoding a single thumbnail can easily take several milliseconds, so
+	 * this keeps the dialog responsive while a page fills in.
+	 */
+	kMetaInfoLoadBudget = 20
+};
+
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
 	_curPage(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons() {
@@ -793,6 +802,7 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 
 void SaveLoadChooserGrid::updateSaveList() {
 	SaveLoadChooserDialog::updateSaveList();
+	_metaInfoCache.clear();
 	updateSaves();
 	draw();
 }
@@ -801,6 +811,7 @@ void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
 	listSaves();
+	_metaInfoCache.clear();
 	_resultString.clear();
 
 	// Load information to restore the last page the user had open.
@@ -976,6 +987,13 @@ void SaveLoadChooserGrid::close() {
 
 	SaveLoadChooserDialog::close();
 	hideButtons();
+	_metaInfoCache.clear();
+}
+
+void SaveLoadChooserGrid::handleTickle() {
+	loadPendingSaves();
+
+	SaveLoadChooserDialog::handleTickle();
 }
 
 int SaveLoadChooserGrid::runIntern() {
@@ -1026,9 +1044,12 @@ void SaveLoadChooserGrid::destroyButtons() {
 	}
 
 	_buttons.clear();
+	_pendingSaves.clear();
 }
 
 void SaveLoadChooserGrid::hideButtons() {
+	_pendingSaves.clear();
+
 	for (ButtonArray::iterator i = _buttons.begin(), end = _buttons.end(); i != end; ++i) {
 		i->button->setGfx(0);
 		i->setVisible(false);
@@ -1039,57 +1060,27 @@ void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
-
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
-
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
-
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
 
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
+		if (_saveList[i].getLocked()) {
+			updateSlot(curButton, _saveList[i]);
+			continue;
 		}
 
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
+		MetaInfoCache::const_iterator cached = _metaInfoCache.find(_saveList[i].getSaveSlot());
+		if (cached != _metaInfoCache.end()) {
+			updateSlot(curButton, cached->_value);
+			continue;
 		}
 
-		//that would make it look "disabled" if slot is locked
-		curButton.button->setEnabled(!desc.getLocked());
-		curButton.description->setEnabled(!desc.getLocked());
+		// Querying the meta infos means reading the save and decoding its
+		// thumbnail. Show what the save list already tells us for now and
+		// load the rest from handleTickle(). The button stays disabled until
+		// then, since we do not know yet whether the slot is write protected.
+		updateSlot(curButton, _saveList[i]);
+		curButton.button->setEnabled(false);
+		_pendingSaves.push_back(i);
 	}
 
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
@@ -1106,6 +1097,75 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlot(SlotButton &button, const SaveStateDescriptor &desc) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		button.button->setGfx(thumbnail);
+	} else {
+		button.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	button.description->setLabel(Common::String::format("%d. %s", desc.getSaveSlot(), desc.getDescription().c_str()));
+
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	button.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	if (_saveMode && desc.getWriteProtectedFlag()) {
+		button.button->setEnabled(false);
+	} else {
+		button.button->setEnabled(true);
+	}
+
+	//that would make it look "disabled" if slot is locked
+	button.button->setEnabled(!desc.getLocked());
+	button.description->setEnabled(!desc.getLocked());
+}
+
+void SaveLoadChooserGrid::loadPendingSaves() {
+	const uint32 start = g_system->getMillis(true);
+
+	while (!_pendingSaves.empty() && g_system->getMillis(true) - start < kMetaInfoLoadBudget) {
+		const uint i = _pendingSaves.front();
+		_pendingSaves.remove_at(0);
+
+		const int saveSlot = _saveList[i].getSaveSlot();
+		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
+		// Keep the slot number of the list, in case the engine could not
+		// read the save.
+		desc.setSaveSlot(saveSlot);
+		_metaInfoCache[saveSlot] = desc;
+
+		SlotButton &curButton = _buttons[i - _curPage * _entriesPerPage];
+		updateSlot(curButton, desc);
+		curButton.container->draw();
+	}
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
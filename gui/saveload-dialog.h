@@ -26,6 +26,8 @@
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
 
+#include "common/hashmap.h"
+
 #include "engines/metaengine.h"
 
 namespace GUI {
@@ -203,6 +205,8 @@ public:
 	virtual SaveLoadChooserType getType() const { return kSaveLoadDialogGrid; }
 
 	virtual void close();
+
+	virtual void handleTickle();
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
@@ -243,6 +247,26 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlot(SlotButton &button, const SaveStateDescriptor &desc);
+
+	/**
+	 * Meta infos of all saves queried since the dialog was opened, indexed
+	 * by save slot. Paging back and forth does not query the engine again.
+	 */
+	typedef Common::HashMap<int, SaveStateDescriptor> MetaInfoCache;
+	MetaInfoCache _metaInfoCache;
+
+	/**
+	 * Indices into _saveList of the visible saves which still show a
+	 * placeholder, because their meta infos are not loaded yet.
+	 */
+	Common::Array<uint> _pendingSaves;
+
+	/**
+	 * Loads the meta infos of pending saves until the time budget for one
+	 * tickle is used up.
+	 */
+	void loadPendingSaves();
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
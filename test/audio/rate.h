@@ -0,0 +1,207 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "common/math.h"
+#include "common/stream.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kSamples = 1001
+	};
+
+	static int16 sampleAt(int i) {
+		// Cover the full sample range, including both extremes
+		switch (i % 7) {
+		case 0:
+			return -32768;
+		case 1:
+			return 32767;
+		default:
+			return (int16)(i * 7919);
+		}
+	}
+
+	void copyTestTemplate(const bool isStereo, const bool reverseStereo, const Audio::st_volume_t volL, const Audio::st_volume_t volR) {
+		const int channels = isStereo ? 2 : 1;
+		const int inputSamples = kSamples * channels;
+
+		int16 *input = (int16 *)malloc(sizeof(int16) * inputSamples);
+		for (int i = 0; i < inputSamples; ++i)
+			input[i] = sampleAt(i);
+
+		// Pre-fill the output to exercise the clamping of the summation
+		int16 *output = new int16[kSamples * 2];
+		int16 *expected = new int16[kSamples * 2];
+		for (int i = 0; i < kSamples * 2; ++i)
+			output[i] = expected[i] = sampleAt(i * 3 + 1);
+
+		for (int i = 0; i < kSamples; ++i) {
+			const int16 in0 = input[i * channels];
+			const int16 in1 = isStereo ? input[i * channels + 1] : in0;
+			Audio::clampedAdd(expected[i * 2 + (reverseStereo ? 1 : 0)], (in0 * (int)volL) / Audio::Mixer::kMaxMixerVolume);
+			Audio::clampedAdd(expected[i * 2 + (reverseStereo ? 0 : 1)], (in1 * (int)volR) / Audio::Mixer::kMaxMixerVolume);
+		}
+
+		Common::SeekableReadStream *data = new Common::MemoryReadStream((const byte *)input, sizeof(int16) * inputSamples, DisposeAfterUse::YES);
+		Audio::AudioStream *s = Audio::makeRawStream(data, 22050, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                             | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                             | (isStereo ? Audio::FLAG_STEREO : 0));
+
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 22050, isStereo, reverseStereo);
+		TS_ASSERT_EQUALS(converter->flow(*s, output, kSamples, volL, volR), (int)kSamples);
+		TS_ASSERT_EQUALS(memcmp(output, expected, sizeof(int16) * kSamples * 2), 0);
+
+		delete converter;
+		delete s;
+		delete[] output;
+		delete[] expected;
+	}
+
+	void sincDCTestTemplate(const int inRate, const int outRate, const bool isStereo) {
+		const int channels = isStereo ? 2 : 1;
+		const int inputSamples = inRate / 10 * channels;
+		const int outputFrames = outRate / 20;
+
+		int16 *input = (int16 *)malloc(sizeof(int16) * inputSamples);
+		for (int i = 0; i < inputSamples; ++i)
+			input[i] = 10000;
+
+		Common::SeekableReadStream *data = new Common::MemoryReadStream((const byte *)input, sizeof(int16) * inputSamples, DisposeAfterUse::YES);
+		Audio::AudioStream *s = Audio::makeRawStream(data, inRate, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                             | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                             | (isStereo ? Audio::FLAG_STEREO : 0));
+
+		int16 *output = new int16[outputFrames * 2];
+		memset(output, 0, sizeof(int16) * outputFrames * 2);
+
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo, false, Audio::kRateConverterSinc);
+		TS_ASSERT_EQUALS(converter->flow(*s, output, outputFrames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), outputFrames);
+
+		// Once the filter has settled, a constant signal has to pass through
+		// unchanged (except for rounding).
+		for (int i = outputFrames / 2; i < outputFrames * 2; ++i)
+			TS_ASSERT_DELTA(output[i], 10000, 2);
+
+		delete converter;
+		delete s;
+		delete[] output;
+	}
+
+public:
+	void test_sinc_upsample() {
+		sincDCTestTemplate(11025, 44100, false);
+		sincDCTestTemplate(22050, 48000, true);
+	}
+
+	void test_sinc_downsample() {
+		sincDCTestTemplate(44100, 22050, false);
+		sincDCTestTemplate(48000, 11025, true);
+	}
+
+	void test_sinc_downsample_large_ratio() {
+		// Beyond SINC_MAX_TAPS the output steps over more input frames than
+		// the filter covers.
+		sincDCTestTemplate(96000, 800, false);
+		sincDCTestTemplate(96000, 800, true);
+
+		// Flow in small pieces to hit every position of the output relative
+		// to the history buffer. A slow sine passes through the low-pass
+		// filter, so every output frame has to match the input frame it is
+		// centered on.
+		for (int inputFrames = 9600; inputFrames < 9600 + 20 * 37; inputFrames += 37) {
+			int16 *input = (int16 *)malloc(sizeof(int16) * inputFrames);
+			int16 *expected = new int16[inputFrames];
+			for (int i = 0; i < inputFrames; ++i)
+				expected[i] = input[i] = (int16)(10000 * sin(2 * M_PI * 5 * i / 96000));
+
+			Common::SeekableReadStream *data = new Common::MemoryReadStream((const byte *)input, sizeof(int16) * inputFrames, DisposeAfterUse::YES);
+			Audio::AudioStream *s = Audio::makeRawStream(data, 96000, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+			                                             | Audio::FLAG_LITTLE_ENDIAN
+#endif
+			                                             );
+
+			int16 *output = new int16[200 * 2];
+			memset(output, 0, sizeof(int16) * 200 * 2);
+
+			Audio::RateConverter *converter = Audio::makeRateConverter(96000, 800, false, false, Audio::kRateConverterSinc);
+			int flowed = 0;
+			int len;
+			do {
+				len = converter->flow(*s, output + flowed * 2, 7, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+				flowed += len;
+			} while (len == 7);
+			const int drained = converter->drain(output + flowed * 2, 200 - flowed, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+
+			// One output frame for every 120 input frames, rounded up
+			TS_ASSERT_EQUALS(flowed + drained, (inputFrames + 119) / 120);
+			for (int i = 0; i < flowed; ++i)
+				TS_ASSERT_DELTA(output[i * 2], expected[i * 120], 16);
+
+			delete converter;
+			delete s;
+			delete[] output;
+			delete[] expected;
+		}
+	}
+
+	void test_sinc_drain() {
+		const int inputFrames = 1000;
+
+		int16 *input = (int16 *)malloc(sizeof(int16) * inputFrames);
+		for (int i = 0; i < inputFrames; ++i)
+			input[i] = 10000;
+
+		Common::SeekableReadStream *data = new Common::MemoryReadStream((const byte *)input, sizeof(int16) * inputFrames, DisposeAfterUse::YES);
+		Audio::AudioStream *s = Audio::makeRawStream(data, 11025, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                             | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                             );
+
+		int16 *output = new int16[inputFrames * 4 * 2];
+		memset(output, 0, sizeof(int16) * inputFrames * 4 * 2);
+
+		Audio::RateConverter *converter = Audio::makeRateConverter(11025, 22050, false, false, Audio::kRateConverterSinc);
+		const int flowed = converter->flow(*s, output, inputFrames * 4, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		TS_ASSERT(flowed < inputFrames * 2);
+
+		// The frames still in the filter's delay line have to come out when
+		// draining, and nothing more after that.
+		const int drained = converter->drain(output + flowed * 2, inputFrames * 4 - flowed, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		TS_ASSERT_EQUALS(flowed + drained, inputFrames * 2);
+		TS_ASSERT_EQUALS(converter->drain(output, inputFrames * 4, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), 0);
+
+		for (int i = inputFrames; i < (inputFrames * 2 - 32) * 2; ++i)
+			TS_ASSERT_DELTA(output[i], 10000, 2);
+
+		delete converter;
+		delete s;
+		delete[] output;
+	}
+
+	void test_copy_mono() {
+		copyTestTemplate(false, false, 256, 256);
+		copyTestTemplate(false, false, 200, 13);
+	}
+
+	void test_copy_stereo() {
+		copyTestTemplate(true, false, 256, 256);
+		copyTestTemplate(true, false, 0, 255);
+	}
+
+	void test_copy_stereo_reversed() {
+		copyTestTemplate(true, true, 256, 256);
+		copyTestTemplate(true, true, 77, 190);
+	}
+};
@@ -0,0 +1,205 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear();
+		TS_ASSERT(container2.empty());
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("FOO"));
+		TS_ASSERT(container2.contains("quux"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(0);
+		TS_ASSERT(!container.empty());
+		container.erase(1);
+		TS_ASSERT(!container.empty());
+		container.erase(2);
+		TS_ASSERT(!container.empty());
+		container.erase(3);
+		TS_ASSERT(!container.empty());
+		container.erase(4);
+		TS_ASSERT(container.empty());
+		container[1] = 33;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(1));
+		TS_ASSERT(container.empty());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+		container.setVal(2, 45);
+
+		// We take a const ref now to ensure that the map
+		// is not modified by getVal.
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef.getVal(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(1), -1);
+		TS_ASSERT_EQUALS(containerRef.getVal(2), 45);
+		TS_ASSERT_EQUALS(containerRef.getVal(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getVal(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(17, -10), -10);
+		TS_ASSERT_EQUALS(containerRef.size(), 3u);
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		container.erase(1);
+		container[1] = 42;
+		container.erase(0);
+		container.erase(1);
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::iterator i;
+		for (i = container.begin(); i != container.end(); ++i) {
+			int key = i->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+
+		found = 0;
+		const Common::FlatHashMap<int, int> &containerRef = container;
+		Common::FlatHashMap<int, int>::const_iterator j;
+		for (j = containerRef.begin(); j != containerRef.end(); ++j) {
+			int key = j->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+
+		container.clear();
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<Common::String, int> map1, map2;
+		map1["foo"] = 32;
+		map1["bar"] = 1;
+		map1.erase("bar");
+		map2 = map1;
+		Common::FlatHashMap<Common::String, int> map3(map1);
+		map1["foo"] = 3;
+		TS_ASSERT_EQUALS(map2["foo"], 32);
+		TS_ASSERT_EQUALS(map3["foo"], 32);
+		TS_ASSERT(!map2.contains("bar"));
+		TS_ASSERT_EQUALS(map2.size(), 1u);
+	}
+
+	void test_against_hashmap() {
+		// Perform a long sequence of pseudo random insertions and removals,
+		// forcing the map to grow and to reuse deleted slots, and check that
+		// the result always matches the one of HashMap.
+		Common::FlatHashMap<int, int> flat;
+		Common::HashMap<int, int> reference;
+
+		uint32 seed = 12345;
+		for (int i = 0; i < 20000; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const int key = (seed >> 16) % 3000;
+			if (seed & 0x100) {
+				flat.erase(key);
+				reference.erase(key);
+			} else {
+				flat[key] = i;
+				reference[key] = i;
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (Common::HashMap<int, int>::const_iterator i = reference.begin(); i != reference.end(); ++i)
+			TS_ASSERT_EQUALS(flat.getVal(i->_key, -1), i->_value);
+
+		uint count = 0;
+		for (Common::FlatHashMap<int, int>::const_iterator i = flat.begin(); i != flat.end(); ++i, ++count)
+			TS_ASSERT(reference.contains(i->_key));
+		TS_ASSERT_EQUALS(count, flat.size());
+
+		flat.clear(true);
+		TS_ASSERT(flat.empty());
+		TS_ASSERT(!flat.contains(0));
+	}
+
+	void test_many_strings() {
+		Common::FlatHashMap<Common::String, uint> container;
+		for (uint i = 0; i < 1000; ++i)
+			container[Common::String::format("key%u", i)] = i;
+
+		TS_ASSERT_EQUALS(container.size(), 1000u);
+		for (uint i = 0; i < 1000; ++i)
+			TS_ASSERT_EQUALS(container.getVal(Common::String::format("key%u", i), 1000), i);
+		TS_ASSERT(!container.contains("key1000"));
+	}
+
+	void test_strided_keys() {
+		// Integer keys are hashed with the identity function, so keys with a
+		// power of two stride only differ in their upper bits.
+		Common::FlatHashMap<uint, uint> container;
+		for (uint i = 0; i < 5000; ++i)
+			container[i << 16] = i;
+
+		TS_ASSERT_EQUALS(container.size(), 5000u);
+		for (uint i = 0; i < 5000; ++i)
+			TS_ASSERT_EQUALS(container.getVal(i << 16, 5000), i);
+		TS_ASSERT(!container.contains(1));
+	}
+};
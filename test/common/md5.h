@@ -47,4 +47,26 @@ class MD5TestSuite : public CxxTest::TestSuite {
 		}
 	}
 
+	void test_computeStreamMD5_inPlace() {
+		// The in place hashing of seekable streams has to match hashing the
+		// data as it is read, including the handling of position and length
+		const char *data = md5_test_string[6];
+		const uint32 size = strlen(data);
+
+		for (uint32 start = 0; start < size; start += 7) {
+			for (uint32 length = 0; length < size + 2; length += 5) {
+				Common::MemoryReadStream seekable((const byte *)data, size);
+				Common::MemoryReadStream readable((const byte *)data, size);
+				seekable.seek(start);
+				readable.seek(start);
+
+				Common::String inPlace = Common::computeStreamMD5AsString(seekable, length);
+				Common::String copied = Common::computeStreamMD5AsString((Common::ReadStream &)readable, length);
+				TS_ASSERT_EQUALS(inPlace, copied);
+				TS_ASSERT_EQUALS(seekable.pos(), readable.pos());
+				TS_ASSERT_EQUALS(seekable.eos(), readable.eos());
+			}
+		}
+	}
+
 };
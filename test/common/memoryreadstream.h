@@ -104,4 +104,15 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_get_data_pointer() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		TS_ASSERT_EQUALS(ms.getDataPointer(), contents);
+
+		// The pointer does not depend on the stream position
+		ms.seek(3);
+		TS_ASSERT_EQUALS(ms.getDataPointer(), contents);
+	}
 };
@@ -70,4 +70,16 @@ class SeekableSubReadStreamTestSuite : public CxxTest::TestSuite {
 		b = ssrs.readByte();
 		TS_ASSERT_EQUALS(b, 1);
 	}
+
+	void test_get_data_pointer() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, 10);
+		Common::SeekableSubReadStream ssrs(&ms, 2, 8);
+
+		TS_ASSERT_EQUALS(ssrs.getDataPointer(), contents + 2);
+
+		// Substreams of substreams point into the original data as well
+		Common::SeekableSubReadStream nested(&ssrs, 1, 4);
+		TS_ASSERT_EQUALS(nested.getDataPointer(), contents + 3);
+	}
 };
@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scaler.h"
+#include "graphics/scaler/intern.h"
+
+class ScalerTestSuite : public CxxTest::TestSuite {
+private:
+	static uint32 valueAt(uint32 i) {
+		return i * 2654435761U ^ (i >> 7);
+	}
+
+	// Scalar version of the pattern computed by the hq scalers
+	static int referencePattern(const uint32 *yuvTable, const int *w) {
+		int pattern = 0;
+		int bit = 0;
+		for (int i = 0; i < 9; i++) {
+			if (i == 4)
+				continue;
+			if (w[4] != w[i] && diffYUV(yuvTable[w[4]], yuvTable[w[i]]))
+				pattern |= 1 << bit;
+			bit++;
+		}
+		return pattern;
+	}
+
+	template<typename ColorMask>
+	static uint16 referenceDimmed(uint16 pixel) {
+		uint32 dimmed;
+		dimmed = (((pixel & ColorMask::kRedBlueMask) * 7) >> 3) & ColorMask::kRedBlueMask;
+		dimmed |= (((pixel & ColorMask::kGreenMask) * 7) >> 3) & ColorMask::kGreenMask;
+		return (uint16)dimmed;
+	}
+
+	template<typename ColorMask>
+	void tv2xTemplate(int bitFormat) {
+		InitScalers(bitFormat);
+
+		// Cover the vector loop as well as the scalar tail
+		for (int width = 1; width <= 37; width++) {
+			const int height = 3;
+			const int srcPitch = width + 3;
+			const int dstPitch = width * 2 + 5;
+
+			uint16 *src = new uint16[srcPitch * height];
+			uint16 *dst = new uint16[dstPitch * height * 2];
+			for (int i = 0; i < srcPitch * height; i++)
+				src[i] = (uint16)valueAt(i + width);
+
+			TV2x((const uint8 *)src, srcPitch * sizeof(uint16), (uint8 *)dst, dstPitch * sizeof(uint16), width, height);
+
+			for (int y = 0; y < height; y++) {
+				for (int x = 0; x < width; x++) {
+					const uint16 pixel = src[y * srcPitch + x];
+					const uint16 dimmed = referenceDimmed<ColorMask>(pixel);
+					const uint16 *line0 = dst + y * 2 * dstPitch + x * 2;
+					const uint16 *line1 = line0 + dstPitch;
+					TS_ASSERT_EQUALS(line0[0], pixel);
+					TS_ASSERT_EQUALS(line0[1], pixel);
+					TS_ASSERT_EQUALS(line1[0], dimmed);
+					TS_ASSERT_EQUALS(line1[1], dimmed);
+				}
+			}
+
+			delete[] src;
+			delete[] dst;
+		}
+
+		DestroyScalers();
+	}
+
+public:
+	void test_hqx_pattern() {
+		// Colors around a common base, so that many of the Y, U and V
+		// differences lie right at the thresholds of diffYUV
+		const int tableSize = 64;
+		uint32 yuvTable[tableSize];
+		for (int i = 0; i < tableSize; i++) {
+			const uint32 value = valueAt(i);
+			const int y = 0x80 + (int)(value % 0x61) - 0x30;
+			const int u = 0x80 + (int)((value >> 8) % 15) - 7;
+			const int v = 0x80 + (int)((value >> 16) % 13) - 6;
+			yuvTable[i] = (y << 16) | (u << 8) | v;
+		}
+		// Different colors with the same YUV value
+		yuvTable[tableSize - 1] = yuvTable[0];
+
+		for (uint32 n = 0; n < 100000; n++) {
+			int w[9];
+			for (int i = 0; i < 9; i++)
+				w[i] = valueAt(n * 9 + i) % tableSize;
+
+			TS_ASSERT_EQUALS(hqxPattern(yuvTable, w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7], w[8]), referencePattern(yuvTable, w));
+		}
+	}
+
+	void test_tv2x_565() {
+		tv2xTemplate<Graphics::ColorMasks<565> >(565);
+	}
+
+	void test_tv2x_555() {
+		tv2xTemplate<Graphics::ColorMasks<555> >(555);
+	}
+};
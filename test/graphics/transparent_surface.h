@@ -0,0 +1,282 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/math.h"
+
+#include "graphics/transparent_surface.h"
+#include "graphics/transform_tools.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite {
+private:
+	static uint32 pixelAt(int i) {
+		const uint32 value = (uint32)i * 2654435761U;
+		// Make sure fully transparent and fully opaque source pixels show up
+		switch (i % 5) {
+		case 0:
+			return value & ~0xFFU;
+		case 1:
+			return value | 0xFF;
+		default:
+			return value;
+		}
+	}
+
+	static uint32 channel(uint32 pixel, int index) {
+		return (pixel >> (index * 8)) & 0xFF;
+	}
+
+	// Straightforward version of the blend loops. Channel index 0 is alpha,
+	// followed by blue, green and red.
+	static uint32 referencePixel(uint32 src, uint32 dst, uint32 color, Graphics::TSpriteBlendMode blendMode) {
+		uint32 out[4], in[4];
+		for (int i = 0; i < 4; i++) {
+			in[i] = channel(src, i);
+			out[i] = channel(dst, i);
+		}
+		const uint32 mod[4] = { (color >> 24) & 0xFF, color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF };
+		const bool colorMod = (color != 0xFFFFFFFF);
+		const uint32 a = in[0];
+		const uint32 ina = colorMod ? a * mod[0] >> 8 : a;
+
+		switch (blendMode) {
+		case Graphics::BLEND_ADDITIVE:
+			for (int i = 1; i < 4; i++) {
+				if (!colorMod)
+					out[i] = MIN<uint32>(out[i] + (in[i] * a >> 8), 255);
+				else if (mod[i] != 255)
+					out[i] = MIN<uint32>(out[i] + (in[i] * mod[i] * ina >> 16), 255);
+				else
+					out[i] = MIN<uint32>(out[i] + (in[i] * ina >> 8), 255);
+			}
+			break;
+
+		case Graphics::BLEND_SUBTRACTIVE:
+			if (colorMod)
+				out[0] = 255;
+			for (int i = 1; i < 4; i++) {
+				if (colorMod && mod[i] != 255)
+					out[i] -= in[i] * mod[i] * out[i] * a >> 24;
+				else
+					out[i] -= in[i] * out[i] * a >> 16;
+			}
+			break;
+
+		case Graphics::BLEND_MULTIPLY:
+			if (!colorMod && a == 0)
+				break;
+			for (int i = 1; i < 4; i++) {
+				if (colorMod && mod[i] != 255)
+					out[i] = out[i] * (in[i] * mod[i] * ina >> 16) >> 8;
+				else
+					out[i] = out[i] * (in[i] * ina >> 8) >> 8;
+			}
+			break;
+
+		default:
+			if (!colorMod && a == 0)
+				break;
+			out[0] = 255;
+			for (int i = 1; i < 4; i++) {
+				if (!colorMod)
+					out[i] = (in[i] * a + out[i] * (255 - a)) >> 8;
+				else
+					out[i] = (out[i] * (255 - ina) >> 8) + (in[i] * ina * mod[i] >> 16);
+			}
+			break;
+		}
+
+		return out[0] | (out[1] << 8) | (out[2] << 16) | (out[3] << 24);
+	}
+
+	void blitTemplate(Graphics::TSpriteBlendMode blendMode, uint32 color, int flipping, int width, int height) {
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+		// The target is wider than the blit to catch writes past the end of a row
+		const int targetWidth = width + 5;
+
+		Graphics::TransparentSurface source;
+		source.create(width, height, format);
+		Graphics::Surface target;
+		target.create(targetWidth, height, format);
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++)
+				*(uint32 *)source.getBasePtr(x, y) = pixelAt(y * width + x);
+			for (int x = 0; x < targetWidth; x++)
+				*(uint32 *)target.getBasePtr(x, y) = pixelAt((y * targetWidth + x) * 3 + 7);
+		}
+
+		source.blit(target, 0, 0, flipping, nullptr, color, -1, -1, blendMode);
+
+		for (int y = 0; y < height; y++) {
+			const int srcY = (flipping & Graphics::FLIP_V) ? height - 1 - y : y;
+			for (int x = 0; x < targetWidth; x++) {
+				const uint32 dst = pixelAt((y * targetWidth + x) * 3 + 7);
+				uint32 expected = dst;
+				if (x < width) {
+					const int srcX = (flipping & Graphics::FLIP_H) ? width - 1 - x : x;
+					expected = referencePixel(pixelAt(srcY * width + srcX), dst, color, blendMode);
+				}
+				TS_ASSERT_EQUALS(*(const uint32 *)target.getBasePtr(x, y), expected);
+			}
+		}
+
+		source.free();
+		target.free();
+	}
+
+	void blendModeTemplate(Graphics::TSpriteBlendMode blendMode) {
+		static const uint32 colors[] = {
+			0xFFFFFFFF,
+			0xFF804020,
+			0x80FFFFFF,
+			0x01FF7FFF,
+			0xC0FFFF00
+		};
+		static const int flips[] = {
+			Graphics::FLIP_NONE,
+			Graphics::FLIP_H,
+			Graphics::FLIP_V,
+			Graphics::FLIP_HV
+		};
+
+		for (int c = 0; c < ARRAYSIZE(colors); c++) {
+			for (int f = 0; f < ARRAYSIZE(flips); f++) {
+				blitTemplate(blendMode, colors[c], flips[f], 3, 2);
+				blitTemplate(blendMode, colors[c], flips[f], 37, 5);
+			}
+		}
+	}
+
+	// Scalar version of the bilinear interpolation between four pixels.
+	// ex and ey are the 16 bit fractional sample position.
+	static uint32 referenceBilinear(uint32 c00, uint32 c01, uint32 c10, uint32 c11, int ex, int ey) {
+		uint32 result = 0;
+		for (int i = 0; i < 4; i++) {
+			const int p00 = channel(c00, i), p01 = channel(c01, i);
+			const int p10 = channel(c10, i), p11 = channel(c11, i);
+			const int t1 = ((((p01 - p00) * ex) >> 16) + p00) & 0xff;
+			const int t2 = ((((p11 - p10) * ex) >> 16) + p10) & 0xff;
+			result |= (uint32)(((((t2 - t1) * ey) >> 16) + t1) & 0xff) << (i * 8);
+		}
+		return result;
+	}
+
+	static void fillSource(Graphics::TransparentSurface &source, int width, int height) {
+		source.create(width, height, Graphics::TransparentSurface::getSupportedPixelFormat());
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++)
+				*(uint32 *)source.getBasePtr(x, y) = pixelAt(y * width + x);
+		}
+	}
+
+	void scaleBilinearTemplate(int srcW, int srcH, int dstW, int dstH) {
+		Graphics::TransparentSurface source;
+		fillSource(source, srcW, srcH);
+
+		Graphics::TransparentSurface *scaled = source.scaleT<Graphics::FILTER_BILINEAR>(dstW, dstH);
+		TS_ASSERT_EQUALS(scaled->w, dstW);
+		TS_ASSERT_EQUALS(scaled->h, dstH);
+
+		// Same sample positions as scaleT()
+		const int sx = (int)(65536.0f * (float)(srcW - 1) / (float)(dstW - 1));
+		const int sy = (int)(65536.0f * (float)(srcH - 1) / (float)(dstH - 1));
+		bool highWeights = false;
+		for (int y = 0; y < dstH; y++) {
+			const int posY = MIN(y * sy, (srcH << 16) - 1);
+			const int y0 = posY >> 16;
+			const int y1 = (y0 < srcH - 1) ? y0 + 1 : y0;
+			for (int x = 0; x < dstW; x++) {
+				const int posX = MIN(x * sx, (srcW << 16) - 1);
+				const int x0 = posX >> 16;
+				const int x1 = (x0 < srcW - 1) ? x0 + 1 : x0;
+				const uint32 expected = referenceBilinear(pixelAt(y0 * srcW + x0), pixelAt(y0 * srcW + x1),
+				                                          pixelAt(y1 * srcW + x0), pixelAt(y1 * srcW + x1),
+				                                          posX & 0xffff, posY & 0xffff);
+				TS_ASSERT_EQUALS(*(const uint32 *)scaled->getBasePtr(x, y), expected);
+				highWeights |= (posX & 0x8000) && (posY & 0x8000);
+			}
+		}
+		TS_ASSERT(highWeights);
+
+		scaled->free();
+		delete scaled;
+		source.free();
+	}
+
+	void rotoscaleBilinearTemplate(int srcW, int srcH, int zoomX, int zoomY, uint32 angle) {
+		Graphics::TransparentSurface source;
+		fillSource(source, srcW, srcH);
+
+		const Graphics::TransformStruct transform(zoomX, zoomY, angle, srcW / 2, srcH / 2, Graphics::BLEND_NORMAL, Graphics::kDefaultRgbaMod);
+		Graphics::TransparentSurface *rotated = source.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
+
+		// Same sample positions as rotoscaleT()
+		Common::Point newHotspot;
+		const Common::Rect rect = Graphics::TransformTools::newRect(Common::Rect(0, 0, srcW, srcH), transform, &newHotspot);
+		TS_ASSERT_EQUALS(rotated->w, rect.width());
+		TS_ASSERT_EQUALS(rotated->h, rect.height());
+
+		const uint32 invAngle = 360 - (angle % 360);
+		const float invCos = cos(invAngle * M_PI / 180.0);
+		const float invSin = sin(invAngle * M_PI / 180.0);
+		const int icosx = (int)(invCos * (65536.0f * Graphics::kDefaultZoomX / zoomX));
+		const int isinx = (int)(invSin * (65536.0f * Graphics::kDefaultZoomX / zoomX));
+		const int icosy = (int)(invCos * (65536.0f * Graphics::kDefaultZoomY / zoomY));
+		const int isiny = (int)(invSin * (65536.0f * Graphics::kDefaultZoomY / zoomY));
+
+		int samples = 0;
+		bool highWeights = false;
+		for (int y = 0; y < rotated->h; y++) {
+			const int t = newHotspot.y - y;
+			int sdx = -icosx * newHotspot.x + isinx * t + ((srcW / 2) << 16);
+			int sdy = -isiny * newHotspot.x - icosy * t + ((srcH / 2) << 16);
+			for (int x = 0; x < rotated->w; x++, sdx += icosx, sdy += isiny) {
+				const int x0 = sdx >> 16;
+				const int y0 = sdy >> 16;
+				if (x0 < 0 || y0 < 0 || x0 >= srcW - 1 || y0 >= srcH - 1)
+					continue;
+
+				const uint32 expected = referenceBilinear(pixelAt(y0 * srcW + x0), pixelAt(y0 * srcW + x0 + 1),
+				                                          pixelAt((y0 + 1) * srcW + x0), pixelAt((y0 + 1) * srcW + x0 + 1),
+				                                          sdx & 0xffff, sdy & 0xffff);
+				TS_ASSERT_EQUALS(*(const uint32 *)rotated->getBasePtr(x, y), expected);
+				highWeights |= (sdx & 0x8000) && (sdy & 0x8000);
+				samples++;
+			}
+		}
+		TS_ASSERT(samples > 0);
+		TS_ASSERT(highWeights);
+
+		rotated->free();
+		delete rotated;
+		source.free();
+	}
+
+public:
+	void test_scale_bilinear() {
+		// 5 -> 9 puts every other sample exactly halfway between two pixels
+		scaleBilinearTemplate(5, 5, 9, 9);
+		scaleBilinearTemplate(7, 4, 23, 13);
+		scaleBilinearTemplate(16, 12, 5, 7);
+	}
+
+	void test_rotoscale_bilinear() {
+		rotoscaleBilinearTemplate(13, 9, 100, 100, 30);
+		rotoscaleBilinearTemplate(8, 11, 170, 60, 113);
+		rotoscaleBilinearTemplate(20, 20, 45, 45, 271);
+	}
+
+	void test_blit_alpha() {
+		blendModeTemplate(Graphics::BLEND_NORMAL);
+	}
+
+	void test_blit_additive() {
+		blendModeTemplate(Graphics::BLEND_ADDITIVE);
+	}
+
+	void test_blit_subtractive() {
+		blendModeTemplate(Graphics::BLEND_SUBTRACTIVE);
+	}
+
+	void test_blit_multiply() {
+		blendModeTemplate(Graphics::BLEND_MULTIPLY);
+	}
+};
@@ -0,0 +1,134 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+private:
+	enum Subsampling {
+		k444,
+		k420,
+		k410
+	};
+
+	static byte sampleAt(int i) {
+		return (byte)((i * 7919) ^ (i >> 3));
+	}
+
+	static uint8 scaleChannel(int value, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		if (scale == Graphics::YUVToRGBManager::kScaleFull)
+			return CLIP(value, 0, 255);
+
+		return (CLIP(value, 16, 235) - 16) * 255 / 219;
+	}
+
+	// Straightforward version of the conversion done by the lookup tables
+	static uint32 referencePixel(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, byte y, byte u, byte v) {
+		int16 cr = v - 128, cb = u - 128;
+		int r = y + (int16)((0.419 / 0.299) * cr);
+		int g = y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb);
+		int b = y + (int16)((0.587 / 0.331) * cb);
+		return format.RGBToColor(scaleChannel(r, scale), scaleChannel(g, scale), scaleChannel(b, scale));
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)surface.getBasePtr(x, y);
+		return *(const uint32 *)surface.getBasePtr(x, y);
+	}
+
+	void convertTemplate(Subsampling subsampling, const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, int width, int height) {
+		const int shift = (subsampling == k444) ? 0 : (subsampling == k420) ? 1 : 2;
+		const int yPitch = width + 5;
+		// 4:1:0 needs an extra row and column of chroma
+		const int uvPitch = (width >> shift) + 3;
+		const int uvSize = uvPitch * ((height >> shift) + 1);
+
+		byte *ySrc = new byte[yPitch * height];
+		byte *uSrc = new byte[uvSize];
+		byte *vSrc = new byte[uvSize];
+		for (int i = 0; i < yPitch * height; i++)
+			ySrc[i] = sampleAt(i);
+		for (int i = 0; i < uvSize; i++) {
+			uSrc[i] = sampleAt(i * 3 + 1);
+			vSrc[i] = sampleAt(i * 5 + 2);
+		}
+
+		Graphics::Surface surface;
+		surface.create(width, height, format);
+
+		switch (subsampling) {
+		case k444:
+			YUVToRGBMan.convert444(&surface, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+			break;
+		case k420:
+			YUVToRGBMan.convert420(&surface, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+			break;
+		case k410:
+			YUVToRGBMan.convert410(&surface, scale, ySrc, uSrc, vSrc, width, height, yPitch, uvPitch);
+			break;
+		}
+
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				byte u, v;
+				if (subsampling == k410) {
+					// Bilinear interpolation between the four closest chroma samples
+					const int index = (y >> 2) * uvPitch + (x >> 2);
+					const int xDiff = x & 3, yDiff = y & 3;
+					u = (uSrc[index] * (4 - xDiff) * (4 - yDiff) + uSrc[index + 1] * xDiff * (4 - yDiff) +
+					     uSrc[index + uvPitch] * yDiff * (4 - xDiff) + uSrc[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+					v = (vSrc[index] * (4 - xDiff) * (4 - yDiff) + vSrc[index + 1] * xDiff * (4 - yDiff) +
+					     vSrc[index + uvPitch] * yDiff * (4 - xDiff) + vSrc[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+				} else {
+					u = uSrc[(y >> shift) * uvPitch + (x >> shift)];
+					v = vSrc[(y >> shift) * uvPitch + (x >> shift)];
+				}
+
+				const uint32 expected = referencePixel(format, scale, ySrc[y * yPitch + x], u, v);
+				if (getPixel(surface, x, y) != expected) {
+					TS_FAIL(Common::String::format("Pixel (%d, %d) of %dx%d is %08x instead of %08x", x, y, width, height, getPixel(surface, x, y), expected).c_str());
+					y = height;
+					break;
+				}
+			}
+		}
+
+		surface.free();
+		delete[] ySrc;
+		delete[] uSrc;
+		delete[] vSrc;
+	}
+
+	void formatsTemplate(Subsampling subsampling, int width, int height) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		for (int i = 0; i < ARRAYSIZE(formats); i++) {
+			convertTemplate(subsampling, formats[i], Graphics::YUVToRGBManager::kScaleFull, width, height);
+			convertTemplate(subsampling, formats[i], Graphics::YUVToRGBManager::kScaleITU, width, height);
+		}
+	}
+
+public:
+	void test_convert444() {
+		formatsTemplate(k444, 256, 64);
+		formatsTemplate(k444, 13, 3);
+	}
+
+	void test_convert420() {
+		formatsTemplate(k420, 160, 24);
+		formatsTemplate(k420, 38, 6);
+	}
+
+	void test_convert410() {
+		formatsTemplate(k410, 160, 24);
+		formatsTemplate(k410, 44, 8);
+	}
+};
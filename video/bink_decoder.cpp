@@ -31,7 +31,6 @@
 #include "common/textconsole.h"
 #include "common/math.h"
 #include "common/stream.h"
-#include "common/substream.h"
 #include "common/file.h"
 #include "common/str.h"
 #include "common/bitstream.h"
@@ -152,6 +151,7 @@ void BinkDecoder::close() {
 
 	_audioTracks.clear();
 	_frames.clear();
+	_packet.clear();
 }
 
 void BinkDecoder::readNextPacket() {
@@ -167,11 +167,24 @@ void BinkDecoder::readNextPacket() {
 
 	uint32 frameSize = frame.size;
 
+	// The buffer only ever grows, so it ends up the size of the largest packet
+	if (_packet.size() < frameSize)
+		_packet.resize(frameSize);
+
+	if (_bink->read(_packet.begin(), frameSize) != frameSize)
+		error("Bink packet read error");
+
+	const byte *packet = _packet.begin();
+
 	for (uint32 i = 0; i < _audioTracks.size(); i++) {
 		AudioInfo &audio = _audioTracks[i];
 
-		uint32 audioPacketLength = _bink->readUint32LE();
+		if (frameSize < 4)
+			error("Audio packet too big for the frame");
 
+		uint32 audioPacketLength = READ_LE_UINT32(packet);
+
+		packet    += 4;
 		frameSize -= 4;
 
 		if (frameSize < audioPacketLength)
@@ -180,31 +193,25 @@ void BinkDecoder::readNextPacket() {
 		if (audioPacketLength >= 4) {
 			// Get our track - audio index plus one as the first track is video
 			BinkAudioTrack *audioTrack = (BinkAudioTrack *)getTrack(i + 1);
-			uint32 audioPacketStart = _bink->pos();
-			uint32 audioPacketEnd   = _bink->pos() + audioPacketLength;
 
 			//                  Number of samples in bytes
-			audio.sampleCount = _bink->readUint32LE() / (2 * audio.channels);
+			audio.sampleCount = READ_LE_UINT32(packet) / (2 * audio.channels);
 
-			audio.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-					audioPacketStart + 4, audioPacketEnd), DisposeAfterUse::YES);
+			audio.bits = new Common::BitStreamMemory32LELSB(new Common::BitStreamMemoryStream(packet + 4,
+					audioPacketLength - 4), DisposeAfterUse::YES);
 
 			audioTrack->decodePacket();
 
 			delete audio.bits;
 			audio.bits = 0;
 
-			_bink->seek(audioPacketEnd);
-
+			packet    += audioPacketLength;
 			frameSize -= audioPacketLength;
 		}
 	}
 
-	uint32 videoPacketStart = _bink->pos();
-	uint32 videoPacketEnd   = _bink->pos() + frameSize;
-
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-			videoPacketStart, videoPacketEnd), DisposeAfterUse::YES);
+	frame.bits = new Common::BitStreamMemory32LELSB(new Common::BitStreamMemoryStream(packet,
+			frameSize), DisposeAfterUse::YES);
 
 	videoTrack->decodePacket(frame);
 
@@ -100,7 +100,7 @@ private:
 
 		uint32 sampleCount;
 
-		Common::BitStream32LELSB *bits;
+		Common::BitStreamMemory32LELSB *bits;
 
 		bool first;
 
@@ -133,7 +133,7 @@ private:
 		uint32 offset;
 		uint32 size;
 
-		Common::BitStream32LELSB *bits;
+		Common::BitStreamMemory32LELSB *bits;
 
 		VideoFrame();
 		~VideoFrame();
@@ -357,6 +357,13 @@ private:
 	Common::Array<AudioInfo> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
 
+	/**
+	 * The packet currently being decoded. Whole packets are read into memory
+	 * in one go, so that the bit readers work directly on memory instead of
+	 * pulling every 32-bit word through the file stream.
+	 */
+	Common::Array<byte> _packet;
+
 	void initAudioTrack(AudioInfo &audio);
 };
 
@@ -25,7 +25,9 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h" // for kMaxChannelVolume
 
+#include "common/debug.h"
 #include "common/rational.h"
+#include "common/rect.h"
 #include "common/file.h"
 #include "common/system.h"
 
@@ -49,6 +51,11 @@ VideoDecoder::VideoDecoder() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_decodeAhead = false;
+	_aheadTrack = 0;
+	_aheadFrame = 0;
+	_aheadFrameStartTime = 0;
+	_aheadDirtyPalette = false;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -80,6 +87,20 @@ void VideoDecoder::close() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_decodeAhead = false;
+	_frameCopy.free();
+	dropAheadFrame();
+
+	if (_decodeStats.frames) {
+		Common::String histogram;
+		for (int i = 0; i < kDecodeTimeBuckets; i++)
+			histogram += Common::String::format(" %d", _decodeStats.histogram[i]);
+
+		debug(1, "VideoDecoder: %d frames decoded in %dms, slowest frame took %dms, frames per <1/2/4/8/16/32/64/more ms:%s",
+		      _decodeStats.frames, _decodeStats.totalTime, _decodeStats.maxTime, histogram.c_str());
+	}
+
+	_decodeStats = DecodeStats();
 }
 
 bool VideoDecoder::loadFile(const Common::String &filename) {
@@ -185,31 +206,123 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 	_canSetDither = false;
 
-	readNextPacket();
+	const Graphics::Surface *frame;
 
-	// If we have no next video track at this point, there shouldn't be
-	// any frame available for us to display.
-	if (!_nextVideoTrack)
-		return 0;
+	if (_aheadTrack) {
+		// The frame was already decoded by decodeAhead()
+		frame = _aheadFrame;
+
+		if (_aheadDirtyPalette) {
+			memcpy(_framePalette, _aheadPalette, sizeof(_framePalette));
+			_palette = _framePalette;
+			_dirtyPalette = true;
+		}
+
+		dropAheadFrame();
+	} else {
+		uint32 startTime = g_system->getMillis();
+
+		readNextPacket();
+
+		// If we have no next video track at this point, there shouldn't be
+		// any frame available for us to display.
+		if (!_nextVideoTrack)
+			return 0;
+
+		frame = _nextVideoTrack->decodeNextFrame();
 
-	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
+		addDecodeTime(g_system->getMillis() - startTime);
 
-	if (_nextVideoTrack->hasDirtyPalette()) {
-		_palette = _nextVideoTrack->getPalette();
-		_dirtyPalette = true;
+		if (_nextVideoTrack->hasDirtyPalette()) {
+			_palette = _nextVideoTrack->getPalette();
+			_dirtyPalette = true;
+
+			// The track may overwrite its palette when decoding ahead
+			if (_decodeAhead) {
+				memcpy(_framePalette, _palette, sizeof(_framePalette));
+				_palette = _framePalette;
+			}
+		}
 	}
 
 	// Look for the next video track here for the next decode.
 	findNextVideoTrack();
 
+	// Hand out a copy, so that the next frame can be decoded ahead into
+	// the track's own surface without touching this one.
+	if (_decodeAhead && frame) {
+		if (_frameCopy.w != frame->w || _frameCopy.h != frame->h || _frameCopy.format != frame->format)
+			_frameCopy.create(frame->w, frame->h, frame->format);
+
+		_frameCopy.copyRectToSurface(*frame, 0, 0, Common::Rect(frame->w, frame->h));
+		frame = &_frameCopy;
+	}
+
 	return frame;
 }
 
+bool VideoDecoder::decodeAhead() {
+	// The frame returned last is not a copy, so it would be overwritten
+	if (!_decodeAhead) {
+		_decodeAhead = true;
+		return false;
+	}
+
+	if (_aheadTrack || !hasFramesLeft() || endOfVideo() || !_nextVideoTrack || _nextVideoTrack->isReversed())
+		return false;
+
+	_canSetDither = false;
+
+	uint32 startTime = g_system->getMillis();
+
+	readNextPacket();
+
+	if (!_nextVideoTrack)
+		return false;
+
+	_aheadFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	_aheadFrame = _nextVideoTrack->decodeNextFrame();
+	_aheadTrack = _nextVideoTrack;
+
+	addDecodeTime(g_system->getMillis() - startTime);
+
+	_aheadDirtyPalette = _nextVideoTrack->hasDirtyPalette();
+	if (_aheadDirtyPalette)
+		memcpy(_aheadPalette, _nextVideoTrack->getPalette(), sizeof(_aheadPalette));
+
+	return true;
+}
+
+void VideoDecoder::dropAheadFrame() {
+	_aheadTrack = 0;
+	_aheadFrame = 0;
+	_aheadDirtyPalette = false;
+}
+
+void VideoDecoder::addDecodeTime(uint32 elapsed) {
+	_decodeStats.frames++;
+	_decodeStats.totalTime += elapsed;
+	_decodeStats.maxTime = MAX(_decodeStats.maxTime, elapsed);
+
+	uint bucket = 0;
+	while (elapsed && bucket < kDecodeTimeBuckets - 1) {
+		elapsed >>= 1;
+		bucket++;
+	}
+
+	_decodeStats.histogram[bucket]++;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// The track is already past a frame decoded ahead, which would not fit
+	// in the reversed order anymore
+	if (reverse)
+		dropAheadFrame();
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -236,6 +349,10 @@ int VideoDecoder::getCurFrame() const {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
 			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
 
+	// A frame decoded ahead is not the current one yet
+	if (_aheadTrack)
+		frame--;
+
 	return frame;
 }
 
@@ -275,7 +392,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = _aheadTrack ? _aheadFrameStartTime : _nextVideoTrack->getNextFrameStartTime();
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -293,6 +410,10 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 }
 
 bool VideoDecoder::endOfVideo() const {
+	// The track may have ended, but the frame decoded ahead is still to come
+	if (_aheadTrack)
+		return false;
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
@@ -320,6 +441,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	dropAheadFrame();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -354,6 +477,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	dropAheadFrame();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -860,6 +985,9 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 }
 
 bool VideoDecoder::endOfVideoTracks() const {
+	if (_aheadTrack)
+		return false;
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack())
 			return false;
@@ -915,6 +1043,9 @@ bool VideoDecoder::hasFramesLeft() const {
 	// This is similar to endOfVideo(), except it doesn't take Audio into account (and returns true if not the end of the video)
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
+	if (_aheadTrack)
+		return true;
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() != Track::kTrackTypeVideo)
 			continue;
@@ -29,6 +29,7 @@
 #include "common/rational.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
+#include "graphics/surface.h"
 
 namespace Audio {
 class AudioStream;
@@ -40,10 +41,6 @@ namespace Common {
 class SeekableReadStream;
 }
 
-namespace Graphics {
-struct Surface;
-}
-
 namespace Video {
 
 /**
@@ -52,7 +49,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder() { _frameCopy.free(); }
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -355,6 +352,24 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode the next frame ahead of time, so that the following
+	 * decodeNextFrame() call returns it without decoding anything.
+	 *
+	 * This is meant to be called right after a frame has been displayed,
+	 * so that an expensive frame is decoded while waiting for it to become
+	 * due, instead of delaying its display. Timing, getCurFrame() and
+	 * endOfVideo() do not change until the frame is returned by
+	 * decodeNextFrame().
+	 *
+	 * The first call only prepares for this: from then on, decodeNextFrame()
+	 * returns a copy of each frame, which stays valid while the next one is
+	 * decoded ahead. Reversing the playback drops a frame decoded ahead.
+	 *
+	 * @return whether a frame was decoded
+	 */
+	bool decodeAhead();
+
 	/**
 	 * Set the default high color format for videos that convert from YUV.
 	 *
@@ -964,6 +979,50 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	enum {
+		/** Number of buckets in DecodeStats::histogram. */
+		kDecodeTimeBuckets = 8
+	};
+
+	/**
+	 * Timing of the frames decoded by decodeNextFrame(), printed at debug
+	 * level 1 when the video is closed.
+	 *
+	 * Bucket 0 of the histogram counts the frames decoded in less than 1ms,
+	 * bucket n (n > 0) the ones which took [2^(n-1), 2^n) ms. The last
+	 * bucket also counts everything slower than that.
+	 */
+	struct DecodeStats {
+		DecodeStats() : frames(0), totalTime(0), maxTime(0) {
+			memset(histogram, 0, sizeof(histogram));
+		}
+
+		/** Number of frames decoded. */
+		uint32 frames;
+		/** Time (in ms) spent decoding all of them. */
+		uint32 totalTime;
+		/** Time (in ms) spent on the slowest frame. */
+		uint32 maxTime;
+		/** Number of frames per decoding time bucket. */
+		uint32 histogram[kDecodeTimeBuckets];
+	};
+
+	DecodeStats _decodeStats;
+	void addDecodeTime(uint32 elapsed);
+
+	// Decoding ahead, see decodeAhead()
+	bool _decodeAhead;
+	/** Copy of the frame returned last, and its palette */
+	Graphics::Surface _frameCopy;
+	byte _framePalette[256 * 3];
+	/** The track of the frame decoded ahead, or 0 if there is none */
+	VideoTrack *_aheadTrack;
+	const Graphics::Surface *_aheadFrame;
+	uint32 _aheadFrameStartTime;
+	bool _aheadDirtyPalette;
+	byte _aheadPalette[256 * 3];
+	void dropAheadFrame();
 };
 
 } // End of namespace Video